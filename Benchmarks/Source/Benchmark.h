@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 20 Oct 2026 9:12:40am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <iomanip>
+#include <iostream>
+
+// Timing shared by the benchmarks. Everything is rendered at 48 kHz in
+// 64 sample blocks, and a figure is the time taken to render one second of
+// audio as a percentage of one core. Each figure is the fastest of several
+// runs, so other work on the machine shows up in it as little as possible.
+namespace Benchmark
+{
+    constexpr double sampleRate { 48000.0 };
+    constexpr int blockSize { 64 };
+
+    // Calls render (numSamples) for seconds of audio, after one second to warm up
+    template <typename Function>
+    double measureLoad (Function&& render, const double seconds = 0.25, const int numRuns = 100)
+    {
+        juce::ScopedNoDenormals noDenormals;
+        const auto numBlocks = juce::roundToInt (seconds * sampleRate) / blockSize;
+
+        for (int block = 0; block < (int) sampleRate / blockSize; ++block)
+            render (blockSize);
+
+        auto fastest = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            for (int block = 0; block < numBlocks; ++block)
+                render (blockSize);
+
+            const auto elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+            fastest = juce::jmin (fastest, elapsed);
+        }
+
+        return 100.0 * fastest * sampleRate / (numBlocks * blockSize);
+    }
+
+    inline void printHeading (const char* heading)
+    {
+        std::cout << "\n" << heading << "\n";
+    }
+
+    inline void printLoad (const char* name, const double load)
+    {
+        std::cout << "  " << std::left << std::setw (36) << name
+                  << std::right << std::fixed << std::setprecision (3) << std::setw (9) << load << " % of one core\n";
+    }
+}
+
+// One per area; Main.cpp runs the ones named on the command line, or all of them
+void runOscillatorBenchmarks();
+void runConvolutionBenchmarks();
+void runReverbBenchmarks();
+void runPrecisionBenchmarks();
+void runOversamplingBenchmarks();
+void runEnvelopeBenchmarks();
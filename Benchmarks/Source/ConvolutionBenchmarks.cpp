@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    ConvolutionBenchmarks.cpp
+    Created: 20 Oct 2026 11:02:54am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../../Source/Data/ConvolutionData.h"
+
+namespace
+{
+    constexpr double impulseSeconds { 5.0 };
+    constexpr int numChannels { 2 };
+
+    // Stereo convolution with partitionSize pieces of numPartitions partitions,
+    // run whenever a whole partition of input has come in, as ConvolutionData does
+    double measureConvolver (const int partitionSize, const int numPartitions)
+    {
+        juce::Random random (1);
+        std::vector<float> impulse ((size_t) (partitionSize * numPartitions));
+        std::vector<float> input ((size_t) partitionSize);
+        std::vector<float> output ((size_t) partitionSize);
+
+        for (auto& sample : impulse)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        for (auto& sample : input)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        const auto spectra = PartitionedConvolver::transformPartitions (impulse.data(), (int) impulse.size(), partitionSize);
+        std::array<PartitionedConvolver, numChannels> convolvers;
+
+        for (auto& convolver : convolvers)
+            convolver.prepare (partitionSize, numPartitions);
+
+        int filled = 0;
+
+        // A whole number of tail partitions per run, so every run does the same work
+        const auto seconds = 6.0 * ConvolutionData::tailSize / Benchmark::sampleRate;
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            filled += numSamples;
+
+            if (filled < partitionSize)
+                return;
+
+            filled -= partitionSize;
+
+            for (auto& convolver : convolvers)
+                convolver.process (input.data(), spectra.data(), numPartitions, output.data());
+        }, seconds);
+    }
+}
+
+void runConvolutionBenchmarks()
+{
+    Benchmark::printHeading ("Convolution, stereo 5 s impulse response");
+
+    const auto impulseSamples = juce::roundToInt (impulseSeconds * Benchmark::sampleRate);
+    const auto numHeadPartitions = ConvolutionData::headLength / ConvolutionData::headSize;
+    const auto numTailPartitions = PartitionedConvolver::getNumPartitions (impulseSamples - ConvolutionData::headLength, ConvolutionData::tailSize);
+
+    const auto headLoad = measureConvolver (ConvolutionData::headSize, numHeadPartitions);
+    const auto tailLoad = measureConvolver (ConvolutionData::tailSize, numTailPartitions);
+
+    Benchmark::printLoad ("head, audio thread", headLoad);
+    Benchmark::printLoad ("tail, background thread", tailLoad);
+    Benchmark::printLoad ("total", headLoad + tailLoad);
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    EnvelopeBenchmarks.cpp
+    Created: 20 Oct 2026 3:52:40pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../../Source/Data/AdsrData.h"
+
+namespace
+{
+    // As many envelopes as the synth has voices, each on a stereo buffer
+    constexpr int numEnvelopes { 5 };
+
+    constexpr float attack { 0.05f };
+    constexpr float decay { 0.1f };
+    constexpr float sustain { 0.5f };
+    constexpr float release { 0.2f };
+
+    // Each gate is held for half the cycle. The envelopes are staggered a
+    // fifth of a cycle apart, so they are spread across their segments.
+    constexpr int cycleSamples { 24000 };
+
+    struct Gates
+    {
+        // Calls noteOn (e) or noteOff (e) for every envelope whose gate changes in this block
+        template <typename NoteOn, typename NoteOff>
+        void advance (const int numSamples, NoteOn&& noteOn, NoteOff&& noteOff)
+        {
+            for (int e = 0; e < numEnvelopes; ++e)
+            {
+                const auto position = (samplePosition + e * cycleSamples / numEnvelopes) % cycleSamples;
+
+                if (position < numSamples)
+                    noteOn (e);
+                else if (position >= cycleSamples / 2 && position - cycleSamples / 2 < numSamples)
+                    noteOff (e);
+            }
+
+            samplePosition = (samplePosition + numSamples) % cycleSamples;
+        }
+
+        int samplePosition { 0 };
+    };
+
+    // The voice's signal is refilled before every block
+    void fillBuffers (std::vector<juce::AudioBuffer<float>>& buffers, const int numSamples)
+    {
+        for (auto& buffer : buffers)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::fill (buffer.getWritePointer (ch), 0.5f, numSamples);
+    }
+
+    double measureAdsrData (const int curve)
+    {
+        std::vector<AdsrData> envelopes (numEnvelopes);
+        std::vector<juce::AudioBuffer<float>> buffers (numEnvelopes, juce::AudioBuffer<float> (2, Benchmark::blockSize));
+        Gates gates;
+
+        for (auto& envelope : envelopes)
+        {
+            envelope.prepareToPlay (Benchmark::sampleRate, Benchmark::blockSize);
+            envelope.update (attack, decay, sustain, release, curve);
+        }
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            fillBuffers (buffers, numSamples);
+            gates.advance (numSamples,
+                           [&] (const int e) { envelopes[(size_t) e].noteOn(); },
+                           [&] (const int e) { envelopes[(size_t) e].noteOff(); });
+
+            for (size_t e = 0; e < envelopes.size(); ++e)
+                envelopes[e].applyEnvelopeToBuffer (buffers[e], 0, numSamples);
+        });
+    }
+
+    // The per-sample juce::ADSR that AdsrData replaced
+    double measureJuceAdsr()
+    {
+        std::vector<juce::ADSR> envelopes (numEnvelopes);
+        std::vector<juce::AudioBuffer<float>> buffers (numEnvelopes, juce::AudioBuffer<float> (2, Benchmark::blockSize));
+        Gates gates;
+
+        for (auto& envelope : envelopes)
+        {
+            envelope.setSampleRate (Benchmark::sampleRate);
+            envelope.setParameters ({ attack, decay, sustain, release });
+        }
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            fillBuffers (buffers, numSamples);
+            gates.advance (numSamples,
+                           [&] (const int e) { envelopes[(size_t) e].noteOn(); },
+                           [&] (const int e) { envelopes[(size_t) e].noteOff(); });
+
+            for (size_t e = 0; e < envelopes.size(); ++e)
+                envelopes[e].applyEnvelopeToBuffer (buffers[e], 0, numSamples);
+        });
+    }
+}
+
+void runEnvelopeBenchmarks()
+{
+    Benchmark::printHeading ("Envelopes, five stereo voices retriggered every 0.5 s");
+
+    const auto juceLoad = measureJuceAdsr();
+    Benchmark::printLoad ("juce::ADSR", juceLoad);
+
+    for (const auto curve : { AdsrData::linear, AdsrData::exponential })
+    {
+        const auto load = measureAdsrData (curve);
+        Benchmark::printLoad (curve == AdsrData::linear ? "AdsrData, linear" : "AdsrData, exponential", load);
+        std::cout << "    " << std::setprecision (2) << load / juceLoad << " x juce::ADSR\n";
+    }
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 9:10:02am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+// Runs every benchmark, or only the areas given as arguments: Benchmarks osc
+int main (int argc, char* argv[])
+{
+    const std::vector<std::pair<juce::String, std::function<void()>>> benchmarks
+    {
+        { "osc", runOscillatorBenchmarks },
+        { "convolution", runConvolutionBenchmarks },
+        { "reverb", runReverbBenchmarks },
+        { "precision", runPrecisionBenchmarks },
+        { "oversampling", runOversamplingBenchmarks },
+        { "envelope", runEnvelopeBenchmarks }
+    };
+
+    juce::StringArray selected;
+
+    for (int i = 1; i < argc; ++i)
+        selected.add (argv[i]);
+
+    std::cout << "Rendering at " << Benchmark::sampleRate << " Hz in blocks of " << Benchmark::blockSize << " samples\n";
+
+    for (const auto& [name, run] : benchmarks)
+        if (selected.isEmpty() || selected.contains (name))
+            run();
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    OscBenchmarks.cpp
+    Created: 20 Oct 2026 9:31:18am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../../Source/Data/OscData.h"
+
+namespace
+{
+    constexpr float fundamentalHz { 110.0f };
+    constexpr float partialGain { 0.1f };
+
+    // The first numPartials partials outwards from the fundamental, alternating overtones and subharmonics
+    std::array<float, HarmonicData::numPartials> getGains (const int numPartials)
+    {
+        std::array<float, HarmonicData::numPartials> gains {};
+
+        for (int n = 0; n < numPartials; ++n)
+        {
+            const auto offset = (n + 1) / 2;
+            gains[(size_t) (HarmonicData::fundamentalIndex + (n % 2 == 1 ? offset : -offset))] = partialGain;
+        }
+
+        return gains;
+    }
+
+    std::array<float, HarmonicData::numPartials> getIncrements()
+    {
+        std::array<float, HarmonicData::numPartials> increments;
+        const auto& partials = HarmonicData::getPartials();
+
+        for (size_t i = 0; i < increments.size(); ++i)
+            increments[i] = fundamentalHz * partials[i].ratio / (float) Benchmark::sampleRate;
+
+        return increments;
+    }
+
+    // One bank of sines, without unison, envelopes or FM
+    double measureBank (const int renderMode, const int numPartials)
+    {
+        OscData<float> osc;
+        osc.prepareToPlay (Benchmark::sampleRate, Benchmark::blockSize, 1);
+        osc.setIncrements (getIncrements().data());
+        osc.setParams (0, renderMode, getGains (numPartials).data(), 0);
+
+        std::vector<float> output ((size_t) Benchmark::blockSize);
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            std::fill (output.begin(), output.end(), 0.0f);
+            osc.renderNextBlock (output.data(), numSamples, nullptr, nullptr);
+        });
+    }
+
+    // Least squares fit of load = offset + slope * partials
+    std::pair<double, double> fitLine (const std::vector<double>& loads)
+    {
+        const auto n = (double) loads.size();
+        double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+
+        for (size_t i = 0; i < loads.size(); ++i)
+        {
+            const auto x = (double) (i + 1);
+            sumX += x;
+            sumY += loads[i];
+            sumXX += x * x;
+            sumXY += x * loads[i];
+        }
+
+        const auto slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+        return { (sumY - slope * sumX) / n, slope };
+    }
+}
+
+void runOscillatorBenchmarks()
+{
+    Benchmark::printHeading ("Oscillator bank against IFFT, one voice of sines at 110 Hz");
+
+    const std::array<int, 9> printed { 1, 8, 16, 24, 32, 48, 64, 96, HarmonicData::numPartials };
+    std::vector<double> bankLoads, ifftLoads;
+
+    for (int numPartials = 1; numPartials <= HarmonicData::numPartials; ++numPartials)
+    {
+        bankLoads.push_back (measureBank (0, numPartials));
+        ifftLoads.push_back (measureBank (1, numPartials));
+
+        if (std::find (printed.begin(), printed.end(), numPartials) != printed.end())
+        {
+            const auto name = std::to_string (numPartials) + " partials";
+            Benchmark::printLoad ((name + ", oscillators").c_str(), bankLoads.back());
+            Benchmark::printLoad ((name + ", IFFT").c_str(), ifftLoads.back());
+        }
+    }
+
+    // Near the crossing the two differ by less than the noise, so it is taken from a line through every count
+    const auto [bankOffset, bankSlope] = fitLine (bankLoads);
+    const auto [ifftOffset, ifftSlope] = fitLine (ifftLoads);
+
+    if (bankSlope > ifftSlope)
+        std::cout << "  IFFT is cheaper from " << (int) std::ceil ((ifftOffset - bankOffset) / (bankSlope - ifftSlope)) << " partials up\n";
+    else
+        std::cout << "  IFFT is never cheaper\n";
+}
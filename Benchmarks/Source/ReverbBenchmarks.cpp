@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    ReverbBenchmarks.cpp
+    Created: 20 Oct 2026 1:18:06pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../../Source/Data/FdnReverbData.h"
+
+namespace
+{
+    // The defaults of the reverb parameters, with the wet signal turned up
+    constexpr float roomSize { 0.5f };
+    constexpr float damping { 0.5f };
+    constexpr float width { 1.0f };
+    constexpr float dryLevel { 1.0f };
+    constexpr float wetLevel { 0.33f };
+
+    // Stereo noise, refilled before every block as the synth would be
+    struct Input
+    {
+        Input()
+        {
+            juce::Random random (1);
+
+            for (int ch = 0; ch < noise.getNumChannels(); ++ch)
+                for (int s = 0; s < noise.getNumSamples(); ++s)
+                    noise.setSample (ch, s, random.nextFloat() * 0.2f - 0.1f);
+        }
+
+        juce::AudioBuffer<float>& next (const int numSamples)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.copyFrom (ch, 0, noise.getReadPointer (ch), numSamples);
+
+            return buffer;
+        }
+
+        juce::AudioBuffer<float> noise { 2, Benchmark::blockSize };
+        juce::AudioBuffer<float> buffer { 2, Benchmark::blockSize };
+    };
+
+    double measureFreeverb()
+    {
+        juce::dsp::Reverb reverb;
+        juce::Reverb::Parameters parameters;
+        parameters.roomSize = roomSize;
+        parameters.damping = damping;
+        parameters.width = width;
+        parameters.dryLevel = dryLevel;
+        parameters.wetLevel = wetLevel;
+
+        reverb.setParameters (parameters);
+        reverb.prepare ({ Benchmark::sampleRate, (juce::uint32) Benchmark::blockSize, 2 });
+
+        Input input;
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            juce::dsp::AudioBlock<float> block { input.next (numSamples) };
+            reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+        });
+    }
+
+    double measureFdn (const int quality)
+    {
+        FdnReverbData reverb;
+        reverb.prepareToPlay (Benchmark::sampleRate, Benchmark::blockSize, 2);
+        reverb.setParams (roomSize, damping, width, dryLevel, wetLevel, 0.0f, quality);
+
+        Input input;
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            reverb.processNextBlock (input.next (numSamples));
+        });
+    }
+}
+
+void runReverbBenchmarks()
+{
+    Benchmark::printHeading ("Reverb, stereo");
+
+    const auto freeverbLoad = measureFreeverb();
+    Benchmark::printLoad ("Freeverb (juce::dsp::Reverb)", freeverbLoad);
+
+    const std::array<const char*, 4> qualityNames { "FDN Eco, 8 fixed lines", "FDN Standard, 8 modulated lines",
+                                                    "FDN High, 16 fixed lines", "FDN Ultra, 16 modulated lines" };
+
+    for (int quality = FdnReverbData::eco; quality <= FdnReverbData::ultra; ++quality)
+    {
+        const auto load = measureFdn (quality);
+        Benchmark::printLoad (qualityNames[(size_t) quality], load);
+        std::cout << "    " << std::setprecision (2) << load / freeverbLoad << " x Freeverb\n";
+    }
+}
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    VoiceBenchmarks.cpp
+    Created: 20 Oct 2026 2:40:21pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../../Source/SynthVoice.h"
+
+namespace
+{
+    // A2, 110 Hz
+    constexpr int noteNumber { 45 };
+
+    enum Waveform
+    {
+        sine = 0,
+        saw
+    };
+
+    // The default patch: the fundamental and nine partials either side of it at -20 dB
+    std::array<float, HarmonicData::numPartials> getDefaultGains()
+    {
+        std::array<float, HarmonicData::numPartials> gains;
+        const auto& partials = HarmonicData::getPartials();
+
+        for (size_t i = 0; i < gains.size(); ++i)
+            gains[i] = juce::Decibels::decibelsToGain (partials[i].defaultGain);
+
+        return gains;
+    }
+
+    // Equal temperament at the benchmark rate, as TuningData builds it by default
+    const TuningData::IncrementTable& getIncrementTable()
+    {
+        static const auto table = []
+        {
+            auto result = std::make_unique<TuningData::IncrementTable>();
+            const auto& partials = HarmonicData::getPartials();
+
+            for (int note = 0; note < TuningData::numNotes; ++note)
+            {
+                for (size_t i = 0; i < partials.size(); ++i)
+                {
+                    const auto increment = (float) (juce::MidiMessage::getMidiNoteInHertz (note) * partials[i].ratio / Benchmark::sampleRate);
+                    result->increment[(size_t) note][i] = increment < 0.5f ? increment : 0.0f;
+                }
+            }
+
+            return result;
+        }();
+
+        return *table;
+    }
+
+    // One held note through the whole voice, oscillators to envelope, at SampleType
+    template <typename SampleType>
+    double measureVoice (const int waveform, const int oversamplingOrder)
+    {
+        ExpressionData expression;
+        expression.prepareToPlay (Benchmark::sampleRate);
+        LfoData lfos;
+        lfos.prepareToPlay (Benchmark::sampleRate);
+
+        juce::Synthesiser synth;
+        synth.addSound (new SynthSound (expression));
+        auto* voice = new SynthVoice (expression, lfos, 0);
+        synth.addVoice (voice);
+        synth.setCurrentPlaybackSampleRate (Benchmark::sampleRate);
+
+        voice->prepareToPlay (Benchmark::sampleRate, Benchmark::blockSize, 2);
+        voice->setIncrementTable (&getIncrementTable());
+        voice->setOversampling (oversamplingOrder, oversamplingOrder);
+        voice->getAdsr().update (0.01f, 0.1f, 1.0f, 0.4f, AdsrData::linear);
+        voice->getFilterAdsr().update (0.01f, 0.1f, 1.0f, 0.4f, AdsrData::linear);
+
+        const auto gains = getDefaultGains();
+
+        for (auto& osc : voice->getOscillator<SampleType>())
+            osc.setParams (waveform, 0, gains.data(), 0);
+
+        synth.noteOn (1, noteNumber, 1.0f);
+
+        juce::AudioBuffer<SampleType> buffer (2, Benchmark::blockSize);
+        juce::MidiBuffer midiMessages;
+
+        return Benchmark::measureLoad ([&] (const int numSamples)
+        {
+            // Once per control block, as the processor does
+            voice->updateModParams (0, 2000.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+
+            buffer.clear();
+            synth.renderNextBlock (buffer, midiMessages, 0, numSamples);
+        });
+    }
+}
+
+void runPrecisionBenchmarks()
+{
+    Benchmark::printHeading ("Precision, one voice of the default patch at 110 Hz");
+
+    for (const auto waveform : { sine, saw })
+    {
+        const auto name = juce::String (waveform == sine ? "sine" : "saw");
+        const auto floatLoad = measureVoice<float> (waveform, 0);
+        const auto doubleLoad = measureVoice<double> (waveform, 0);
+
+        Benchmark::printLoad ((name + ", float").toRawUTF8(), floatLoad);
+        Benchmark::printLoad ((name + ", double").toRawUTF8(), doubleLoad);
+        std::cout << "    double is " << std::setprecision (2) << doubleLoad / floatLoad << " x float\n";
+    }
+}
+
+void runOversamplingBenchmarks()
+{
+    Benchmark::printHeading ("Oversampling, one voice of the default patch at 110 Hz");
+
+    for (const auto waveform : { sine, saw })
+    {
+        const auto name = juce::String (waveform == sine ? "sine" : "saw");
+        const auto baseLoad = measureVoice<float> (waveform, 0);
+        Benchmark::printLoad ((name + ", 1x").toRawUTF8(), baseLoad);
+
+        for (int order = 1; order <= SynthVoice::maxOversamplingOrder; ++order)
+        {
+            const auto load = measureVoice<float> (waveform, order);
+            Benchmark::printLoad ((name + ", " + juce::String (1 << order) + "x").toRawUTF8(), load);
+            std::cout << "    " << std::setprecision (2) << load / baseLoad << " x 1x\n";
+        }
+    }
+}
@@ -10,12 +10,268 @@
 
 #include "AdsrData.h"
 
-void AdsrData::update (const float attack, const float decay, const float sustain, const float release)
+namespace
 {
-    adsrParams.attack = attack;
-    adsrParams.decay = decay;
-    adsrParams.sustain = sustain;
-    adsrParams.release = release;
-    
-    setParameters (adsrParams);
+    // Fraction of the distance to its target an exponential segment has left
+    // when it ends. The attack aims at 1.2, decay and release at -60 dB past their end.
+    constexpr float attackRatio { 1.0f / 6.0f };
+    constexpr float decayRatio { 0.001f };
 }
+
+void AdsrData::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    envelope.assign ((size_t) samplesPerBlock, 0.0f);
+    reset();
+}
+
+void AdsrData::update (const float attack, const float decay, const float sustain, const float release, const int curve)
+{
+    if (attack == attackTime && decay == decayTime && sustain == sustainLevel && release == releaseTime && curve == curveType)
+        return;
+
+    // A segment in progress keeps the share of its time it still had left
+    const auto oldTime = getSegmentTime (state);
+
+    attackTime = attack;
+    decayTime = decay;
+    sustainLevel = sustain;
+    releaseTime = release;
+    curveType = curve;
+
+    switch (state)
+    {
+        case State::idle:
+            break;
+
+        case State::sustain:
+            level = sustainLevel;
+            break;
+
+        case State::attack:
+        case State::decay:
+        case State::release:
+        {
+            const auto newTime = getSegmentTime (state);
+            startSegment (oldTime > 0.0f ? juce::roundToInt (samplesLeft * newTime / oldTime) : 0);
+            break;
+        }
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            break;
+    }
+}
+
+void AdsrData::noteOn()
+{
+    enterState (State::attack);
+}
+
+void AdsrData::noteOff()
+{
+    if (state != State::idle)
+        enterState (State::release);
+}
+
+void AdsrData::reset()
+{
+    level = 0.0f;
+    samplesLeft = 0;
+    state = State::idle;
+}
+
+float AdsrData::getSegmentTime (const State forState) const
+{
+    switch (forState)
+    {
+        // A retriggered attack starts from the current level at the usual rate
+        case State::attack:     return attackTime * (1.0f - level);
+        case State::decay:      return decayTime;
+        case State::release:    return releaseTime;
+        default:                return 0.0f;
+    }
+}
+
+void AdsrData::enterState (const State newState)
+{
+    state = newState;
+
+    switch (state)
+    {
+        case State::idle:
+            level = 0.0f;
+            break;
+
+        case State::sustain:
+            level = sustainLevel;
+            break;
+
+        case State::attack:
+        case State::decay:
+        case State::release:
+            startSegment (juce::roundToInt (getSegmentTime (state) * currentSampleRate));
+            break;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            break;
+    }
+}
+
+void AdsrData::startSegment (const int numSamples)
+{
+    const auto ratio = state == State::attack ? attackRatio : decayRatio;
+    segmentEnd = state == State::attack ? 1.0f : (state == State::decay ? sustainLevel : 0.0f);
+    samplesLeft = numSamples;
+
+    if (samplesLeft <= 0)
+    {
+        finishSegment();
+        return;
+    }
+
+    step = (segmentEnd - level) / (float) samplesLeft;
+    target = (segmentEnd - ratio * level) / (1.0f - ratio);
+    multiplier = std::pow (ratio, 1.0f / (float) samplesLeft);
+
+    auto power = multiplier;
+
+    for (auto& p : rampPowers)
+    {
+        p = power;
+        power *= multiplier;
+    }
+}
+
+void AdsrData::finishSegment()
+{
+    level = segmentEnd;
+    samplesLeft = 0;
+
+    switch (state)
+    {
+        case State::attack:     enterState (State::decay);      break;
+        case State::decay:      enterState (State::sustain);    break;
+        case State::release:    enterState (State::idle);       break;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            break;
+    }
+}
+
+void AdsrData::fillSegment (float* output, const int numSamples)
+{
+    if (curveType == linear)
+    {
+        for (int s = 0; s < numSamples; ++s)
+            output[s] = level + step * (float) (s + 1);
+
+        level += step * (float) numSamples;
+    }
+    else
+    {
+        // rampLanes samples at once from the same distance, then the distance moves on by all of them
+        auto distance = level - target;
+        int s = 0;
+
+        for (; s + rampLanes <= numSamples; s += rampLanes)
+        {
+            for (int l = 0; l < rampLanes; ++l)
+                output[s + l] = target + distance * rampPowers[(size_t) l];
+
+            distance *= rampPowers[rampLanes - 1];
+        }
+
+        if (s < numSamples)
+        {
+            for (int l = 0; l < numSamples - s; ++l)
+                output[s + l] = target + distance * rampPowers[(size_t) l];
+
+            distance *= rampPowers[(size_t) (numSamples - s - 1)];
+        }
+
+        level = target + distance;
+    }
+
+    samplesLeft -= numSamples;
+
+    if (samplesLeft == 0)
+        finishSegment();
+}
+
+void AdsrData::render (float* output, int numSamples)
+{
+    while (numSamples > 0)
+    {
+        if (state == State::idle || state == State::sustain)
+        {
+            juce::FloatVectorOperations::fill (output, level, numSamples);
+            return;
+        }
+
+        const auto numInSegment = juce::jmin (samplesLeft, numSamples);
+        fillSegment (output, numInSegment);
+        output += numInSegment;
+        numSamples -= numInSegment;
+    }
+}
+
+float AdsrData::skip (int numSamples)
+{
+    while (numSamples > 0 && state != State::idle && state != State::sustain)
+    {
+        const auto numInSegment = juce::jmin (samplesLeft, numSamples);
+
+        if (curveType == linear)
+            level += step * (float) numInSegment;
+        else
+            level = target + (level - target) * std::pow (multiplier, (float) numInSegment);
+
+        samplesLeft -= numInSegment;
+        numSamples -= numInSegment;
+
+        if (samplesLeft == 0)
+            finishSegment();
+    }
+
+    return level;
+}
+
+template <typename SampleType>
+void AdsrData::applyEnvelopeToBuffer (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples)
+{
+    jassert (! envelope.empty());
+
+    while (numSamples > 0)
+    {
+        const auto numThisTime = juce::jmin (numSamples, (int) envelope.size());
+        render (envelope.data(), numThisTime);
+
+        // One envelope for every channel
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch, startSample);
+
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                juce::FloatVectorOperations::multiply (data, envelope.data(), numThisTime);
+            }
+            else
+            {
+                for (int s = 0; s < numThisTime; ++s)
+                    data[s] *= (SampleType) envelope[(size_t) s];
+            }
+        }
+
+        startSample += numThisTime;
+        numSamples -= numThisTime;
+    }
+}
+
+template void AdsrData::applyEnvelopeToBuffer<float> (juce::AudioBuffer<float>&, int, int);
+template void AdsrData::applyEnvelopeToBuffer<double> (juce::AudioBuffer<double>&, int, int);
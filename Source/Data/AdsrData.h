@@ -12,11 +12,77 @@
 
 #include <JuceHeader.h>
 
-class AdsrData : public juce::ADSR
+// An ADSR that is rendered a block at a time. The number of samples left in
+// the current segment is known, so a block is split at segment ends and each
+// piece is filled as a closed form ramp with no branches inside it. The
+// rendered envelope is then multiplied into every channel of the buffer.
+//
+// Segments are either linear or exponential. An exponential segment aims past
+// its end level by a fixed ratio, so it still arrives in exactly its set time.
+class AdsrData
 {
 public:
-    void update (const float attack, const float decay, const float sustain, const float release);
-    
+    enum Curve
+    {
+        linear = 0,
+        exponential
+    };
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock);
+
+    // Times in seconds; curve is one of Curve
+    void update (const float attack, const float decay, const float sustain, const float release, const int curve);
+
+    void noteOn();
+    void noteOff();
+    void reset();
+    bool isActive() const noexcept { return state != State::idle; }
+    float getLevel() const noexcept { return level; }
+
+    // Moves the envelope on by numSamples and returns its level there
+    float skip (int numSamples);
+
+    template <typename SampleType>
+    void applyEnvelopeToBuffer (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples);
+
 private:
-    juce::ADSR::Parameters adsrParams;
+    enum class State
+    {
+        idle,
+        attack,
+        decay,
+        sustain,
+        release
+    };
+
+    // Exponential ramps are filled this many samples at a time
+    static constexpr int rampLanes { 8 };
+
+    void render (float* output, int numSamples);
+    void fillSegment (float* output, const int numSamples);
+    void enterState (const State newState);
+    void startSegment (const int numSamples);
+    void finishSegment();
+    float getSegmentTime (const State forState) const;
+
+    double currentSampleRate { 44100.0 };
+    float attackTime { 0.0f };
+    float decayTime { 0.0f };
+    float sustainLevel { 1.0f };
+    float releaseTime { 0.0f };
+    int curveType { linear };
+
+    State state { State::idle };
+    float level { 0.0f };
+    float segmentEnd { 0.0f };
+    int samplesLeft { 0 };
+
+    // Linear segments add step per sample. Exponential ones approach target,
+    // with rampPowers holding the multiplier raised to 1..rampLanes.
+    float step { 0.0f };
+    float target { 0.0f };
+    float multiplier { 1.0f };
+    alignas (32) std::array<float, rampLanes> rampPowers {};
+
+    std::vector<float> envelope;
 };
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    AnalyzerData.cpp
+    Created: 19 Oct 2026 3:12:40pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "AnalyzerData.h"
+
+AnalyzerData::AnalyzerData()
+: fifoBuffer ((size_t) fifoSize, 0.0f)
+, history ((size_t) fftSize, 0.0f)
+, fftData ((size_t) (2 * fftSize), 0.0f)
+{
+    spectrum.fill (minDecibels);
+    displaySpectrum.fill (minDecibels);
+}
+
+void AnalyzerData::prepareToPlay (double newSampleRate)
+{
+    sampleRate.store (newSampleRate, std::memory_order_relaxed);
+}
+
+void AnalyzerData::pushNextBlock (const juce::AudioBuffer<float>& buffer)
+{
+    // Channel 0 only, and nothing is written when the editor isn't reading
+    const auto numSamples = juce::jmin (buffer.getNumSamples(), fifo.getFreeSpace());
+
+    if (numSamples <= 0 || buffer.getNumChannels() == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    // One pass over the block; it is only split where the ring wraps
+    const auto* input = buffer.getReadPointer (0);
+    std::copy (input, input + size1, fifoBuffer.data() + start1);
+    std::copy (input + size1, input + size1 + size2, fifoBuffer.data() + start2);
+
+    fifo.finishedWrite (size1 + size2);
+}
+
+bool AnalyzerData::update()
+{
+    const auto numReady = fifo.getNumReady();
+
+    if (numReady == 0)
+        return false;
+
+    // Anything older than one FFT frame would be overwritten in the history anyway
+    const auto numToSkip = juce::jmax (0, numReady - fftSize);
+    const auto numToRead = numReady - numToSkip;
+
+    if (numToSkip > 0)
+        fifo.finishedRead (numToSkip);
+
+    std::copy (history.begin() + numToRead, history.end(), history.begin());
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (numToRead, start1, size1, start2, size2);
+
+    auto* destination = history.data() + fftSize - numToRead;
+    std::copy (fifoBuffer.data() + start1, fifoBuffer.data() + start1 + size1, destination);
+    std::copy (fifoBuffer.data() + start2, fifoBuffer.data() + start2 + size2, destination + size1);
+
+    fifo.finishedRead (size1 + size2);
+
+    // Hann window, so a full scale sine reads 0 dB at its peak bin
+    std::copy (history.begin(), history.end(), fftData.begin());
+    window.multiplyWithWindowingTable (fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+    const auto scale = 4.0f / (float) fftSize;
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        const auto level = juce::Decibels::gainToDecibels (fftData[(size_t) i] * scale, minDecibels);
+        spectrum[(size_t) i] = juce::jmax (level, spectrum[(size_t) i] - releaseDecibels);
+    }
+
+    const auto trigger = findTrigger();
+    std::copy (history.begin() + trigger, history.begin() + trigger + scopeSize, scope.begin());
+
+    const juce::SpinLock::ScopedLockType lock (displayLock);
+    displaySpectrum = spectrum;
+    displayScope = scope;
+
+    return true;
+}
+
+int AnalyzerData::findTrigger() const
+{
+    // Latest rising zero crossing that still leaves a full scope window after it
+    const auto latest = fftSize - scopeSize;
+
+    for (int i = latest; i > 0; --i)
+        if (history[(size_t) (i - 1)] < 0.0f && history[(size_t) i] >= 0.0f)
+            return i;
+
+    // Free run when nothing crosses zero
+    return latest;
+}
+
+void AnalyzerData::copySpectrum (std::array<float, numBins>& destination)
+{
+    const juce::SpinLock::ScopedLockType lock (displayLock);
+    destination = displaySpectrum;
+}
+
+void AnalyzerData::copyScope (std::array<float, scopeSize>& destination)
+{
+    const juce::SpinLock::ScopedLockType lock (displayLock);
+    destination = displayScope;
+}
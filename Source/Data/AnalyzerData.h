@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    AnalyzerData.h
+    Created: 19 Oct 2026 3:12:40pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Spectrum and oscilloscope data for the editor. The audio thread copies the
+// output into a wait-free single producer / single consumer FIFO; everything
+// else (windowing, FFT, triggering) runs on the analyzer thread in update(),
+// and the results are copied out for painting on the message thread.
+class AnalyzerData
+{
+public:
+    static constexpr int fftOrder { 12 };
+    static constexpr int fftSize { 1 << fftOrder };
+    static constexpr int numBins { fftSize / 2 + 1 };
+    static constexpr int scopeSize { 512 };
+    static constexpr float minDecibels { -100.0f };
+
+    AnalyzerData();
+
+    void prepareToPlay (double sampleRate);
+
+    // Audio thread
+    void pushNextBlock (const juce::AudioBuffer<float>& buffer);
+    void setFundamental (const float frequency) { fundamental.store (frequency, std::memory_order_relaxed); }
+
+    // Analyzer thread. Returns false when no new samples have arrived.
+    bool update();
+
+    // Message thread
+    void copySpectrum (std::array<float, numBins>& destination);
+    void copyScope (std::array<float, scopeSize>& destination);
+    double getSampleRate() const { return sampleRate.load (std::memory_order_relaxed); }
+    float getFundamental() const { return fundamental.load (std::memory_order_relaxed); }
+
+private:
+    static constexpr int fifoSize { 8 * fftSize };
+    static constexpr float releaseDecibels { 1.5f };
+
+    int findTrigger() const;
+
+    // Sized once in the constructor so a reconfigure never reallocates under the reader
+    juce::AbstractFifo fifo { fifoSize };
+    std::vector<float> fifoBuffer;
+
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<float> fundamental { 0.0f };
+
+    // Analyzer thread
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> history;
+    std::vector<float> fftData;
+    std::array<float, numBins> spectrum;
+    std::array<float, scopeSize> scope {};
+
+    // Copies handed to the message thread
+    juce::SpinLock displayLock;
+    std::array<float, numBins> displaySpectrum;
+    std::array<float, scopeSize> displayScope {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyzerData)
+};
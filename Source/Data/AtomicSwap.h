@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    AtomicSwap.h
+    Created: 19 Oct 2026 1:37:50pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Hands objects built on a background thread to the audio thread without locks.
+// The audio thread never allocates or deletes: it only swaps pointers in acquire(),
+// and the object it replaces is deleted later by collectGarbage() on a thread that
+// does not use the objects itself.
+//
+// When the audio thread passes the object on to the thread that collects, it uses
+// swap() and retire() instead, and hands the new object over in between, so the
+// collecting thread can no longer be reading the old one when it is deleted.
+template <typename ObjectType>
+class AtomicSwap
+{
+public:
+    AtomicSwap() = default;
+
+    ~AtomicSwap()
+    {
+        delete current;
+        delete replaced;
+        delete pending.load();
+        delete retired.load();
+    }
+
+    // Producer thread. Replaces anything the audio thread has not picked up yet.
+    void publish (std::unique_ptr<ObjectType> next)
+    {
+        delete pending.exchange (next.release(), std::memory_order_acq_rel);
+    }
+
+    // Audio thread. Returns the newest published object, or nullptr before the first publish.
+    ObjectType* acquire() noexcept
+    {
+        auto* object = swap();
+        retire();
+        return object;
+    }
+
+    // Audio thread. Like acquire(), but the replaced object is kept from collectGarbage() until retire().
+    ObjectType* swap() noexcept
+    {
+        // Only swap once the previously replaced object has been collected
+        if (replaced == nullptr && retired.load (std::memory_order_acquire) == nullptr)
+        {
+            if (auto* next = pending.exchange (nullptr, std::memory_order_acq_rel))
+            {
+                replaced = current;
+                current = next;
+            }
+        }
+
+        return current;
+    }
+
+    // Audio thread. Lets collectGarbage() delete the object replaced by the last swap().
+    void retire() noexcept
+    {
+        if (replaced == nullptr)
+            return;
+
+        retired.store (replaced, std::memory_order_release);
+        replaced = nullptr;
+    }
+
+    // Deletes the object replaced by the last swap.
+    void collectGarbage()
+    {
+        delete retired.exchange (nullptr, std::memory_order_acq_rel);
+    }
+
+private:
+    ObjectType* current { nullptr };
+    ObjectType* replaced { nullptr };
+    std::atomic<ObjectType*> pending { nullptr };
+    std::atomic<ObjectType*> retired { nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE (AtomicSwap)
+};
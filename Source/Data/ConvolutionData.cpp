@@ -0,0 +1,414 @@
+/*
+  ==============================================================================
+
+    ConvolutionData.cpp
+    Created: 19 Oct 2026 1:37:50pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "ConvolutionData.h"
+
+namespace
+{
+    // Same dry scaling as juce::Reverb so switching engine keeps the dry level
+    constexpr float dryScaleFactor { 2.0f };
+    constexpr float impulseGain { 0.5f };
+
+    int fftOrderFor (const int fftSize)
+    {
+        int order = 0;
+
+        while ((1 << order) < fftSize)
+            ++order;
+
+        return order;
+    }
+}
+
+//==============================================================================
+void PartitionedConvolver::prepare (const int partitionSize, const int maxNumPartitions)
+{
+    size = partitionSize;
+    numBins = size + 1;
+    maxPartitions = juce::jmax (1, maxNumPartitions);
+
+    fft = std::make_unique<juce::dsp::FFT> (fftOrderFor (2 * size));
+    previousInput.assign ((size_t) size, 0.0f);
+    fftBuffer.assign ((size_t) (4 * size), 0.0f);
+    frequencyDelayLine.assign ((size_t) (maxPartitions * 2 * numBins), 0.0f);
+    fdlIndex = 0;
+}
+
+void PartitionedConvolver::process (const float* input, const float* partitionSpectra, const int numPartitions, float* output)
+{
+    const auto binFloats = 2 * numBins;
+
+    // Overlap-save frame: previous partition followed by the new one
+    std::copy (previousInput.begin(), previousInput.end(), fftBuffer.begin());
+    std::copy (input, input + size, fftBuffer.begin() + size);
+    std::fill (fftBuffer.begin() + 2 * size, fftBuffer.end(), 0.0f);
+    std::copy (input, input + size, previousInput.begin());
+
+    fft->performRealOnlyForwardTransform (fftBuffer.data(), true);
+    std::copy (fftBuffer.begin(), fftBuffer.begin() + binFloats, frequencyDelayLine.begin() + fdlIndex * binFloats);
+
+    // Multiply-accumulate every impulse partition with the matching past input spectrum
+    auto* acc = fftBuffer.data();
+    std::fill (fftBuffer.begin(), fftBuffer.end(), 0.0f);
+
+    for (int p = 0; p < juce::jmin (numPartitions, maxPartitions); ++p)
+    {
+        auto slot = fdlIndex - p;
+
+        if (slot < 0)
+            slot += maxPartitions;
+
+        const auto* x = frequencyDelayLine.data() + slot * binFloats;
+        const auto* h = partitionSpectra + p * binFloats;
+
+        for (int b = 0; b < binFloats; b += 2)
+        {
+            acc[b]     += x[b] * h[b]     - x[b + 1] * h[b + 1];
+            acc[b + 1] += x[b] * h[b + 1] + x[b + 1] * h[b];
+        }
+    }
+
+    if (++fdlIndex == maxPartitions)
+        fdlIndex = 0;
+
+    fft->performRealOnlyInverseTransform (fftBuffer.data());
+    std::copy (fftBuffer.begin() + size, fftBuffer.begin() + 2 * size, output);
+}
+
+void PartitionedConvolver::reset()
+{
+    std::fill (previousInput.begin(), previousInput.end(), 0.0f);
+    std::fill (frequencyDelayLine.begin(), frequencyDelayLine.end(), 0.0f);
+    fdlIndex = 0;
+}
+
+std::vector<float> PartitionedConvolver::transformPartitions (const float* impulse, const int numSamples, const int partitionSize)
+{
+    const auto numPartitions = getNumPartitions (numSamples, partitionSize);
+    const auto binFloats = 2 * (partitionSize + 1);
+
+    juce::dsp::FFT transform (fftOrderFor (2 * partitionSize));
+    std::vector<float> buffer ((size_t) (4 * partitionSize));
+    std::vector<float> spectra ((size_t) (numPartitions * binFloats));
+
+    for (int p = 0; p < numPartitions; ++p)
+    {
+        const auto start = p * partitionSize;
+        const auto length = juce::jmin (partitionSize, numSamples - start);
+
+        std::fill (buffer.begin(), buffer.end(), 0.0f);
+        std::copy (impulse + start, impulse + start + length, buffer.begin());
+        transform.performRealOnlyForwardTransform (buffer.data(), true);
+        std::copy (buffer.begin(), buffer.begin() + binFloats, spectra.begin() + p * binFloats);
+    }
+
+    return spectra;
+}
+
+//==============================================================================
+ConvolutionData::ConvolutionData() : juce::Thread ("Convolution Tail")
+{
+    formatManager.registerBasicFormats();
+}
+
+ConvolutionData::~ConvolutionData()
+{
+    stopThread (2000);
+    loaderPool.removeAllJobs (true, 2000);
+}
+
+void ConvolutionData::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+{
+    stopThread (2000);
+
+    const auto sampleRateChanged = sampleRate != currentSampleRate;
+    currentSampleRate = sampleRate;
+    numChannels = juce::jlimit (1, maxChannels, outputChannels);
+
+    const auto maxImpulseSamples = (int) std::ceil (maxImpulseSeconds * sampleRate);
+    const auto maxTailPartitions = PartitionedConvolver::getNumPartitions (maxImpulseSamples - headLength, tailSize);
+
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        headConvolver[(size_t) ch].prepare (headSize, headLength / headSize);
+        headInput[(size_t) ch].assign (headSize, 0.0f);
+        headOutput[(size_t) ch].assign (headSize, 0.0f);
+
+        tailConvolver[(size_t) ch].prepare (tailSize, maxTailPartitions);
+        tailRing[(size_t) ch].assign (tailRingSize, 0.0f);
+
+        for (auto& slot : tailInput)
+            slot[(size_t) ch].assign (tailSize, 0.0f);
+    }
+
+    tailScratch.assign (tailSize, 0.0f);
+
+    dryGain.reset (sampleRate, 0.05);
+    wetGain.reset (sampleRate, 0.05);
+
+    resetAll();
+    startThread();
+
+    // A loaded impulse response has to be resampled for the new rate
+    if (sampleRateChanged && impulseFile.existsAsFile())
+        loadImpulseResponse (impulseFile);
+}
+
+void ConvolutionData::loadImpulseResponse (const juce::File& file)
+{
+    impulseFile = file;
+
+    const auto sampleRate = currentSampleRate;
+
+    // Not prepared yet, prepareToPlay() will load it
+    if (sampleRate <= 0.0)
+        return;
+
+    loaderPool.addJob ([this, file, sampleRate]
+    {
+        if (auto ir = createImpulseResponse (file, sampleRate))
+            impulse.publish (std::move (ir));
+    });
+}
+
+void ConvolutionData::setParams (const float dry, const float wet)
+{
+    dryGain.setTargetValue (dry * dryScaleFactor);
+    wetGain.setTargetValue (wet);
+}
+
+void ConvolutionData::processNextBlock (juce::AudioBuffer<float>& buffer)
+{
+    // The tail thread collects the old impulse response, so it has to see the new one first
+    auto* ir = impulse.swap();
+    tailImpulse.store (ir, std::memory_order_release);
+    impulse.retire();
+
+    const auto channels = juce::jmin (numChannels, buffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+
+    std::array<float*, maxChannels> data {};
+
+    for (int ch = 0; ch < channels; ++ch)
+        data[(size_t) ch] = buffer.getWritePointer (ch);
+
+    for (int s = 0; s < numSamples;)
+    {
+        // The tail output timeline lags the input by the head latency
+        const auto tailPosition = streamPosition - headSize;
+        const auto tailOffset = (int) (((tailPosition % tailSize) + tailSize) % tailSize);
+        const auto n = juce::jmin (numSamples - s, headSize - headFill, tailSize - tailFill, tailSize - tailOffset);
+
+        // Tail chunk k covers positions [(k + 2) * tailSize, (k + 3) * tailSize)
+        const auto chunk = (tailPosition - tailOffset) / tailSize - 2;
+        const auto tailReady = tailPosition >= headLength && chunk < chunksDone.load (std::memory_order_acquire);
+        const auto ringOffset = tailReady ? (int) (tailPosition % tailRingSize) : 0;
+        const auto slot = (int) (chunksSubmitted.load (std::memory_order_relaxed) % numTailSlots);
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            const auto* in = data[(size_t) ch] + s;
+            std::copy (in, in + n, headInput[(size_t) ch].begin() + headFill);
+            std::copy (in, in + n, tailInput[(size_t) slot][(size_t) ch].begin() + tailFill);
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            const auto dry = dryGain.getNextValue();
+            const auto wet = wetGain.getNextValue();
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                auto wetSample = headOutput[(size_t) ch][(size_t) (headFill + i)];
+
+                if (tailReady)
+                    wetSample += tailRing[(size_t) ch][(size_t) (ringOffset + i)];
+
+                auto& sample = data[(size_t) ch][s + i];
+                sample = sample * dry + wetSample * wet;
+            }
+        }
+
+        s += n;
+        headFill += n;
+        tailFill += n;
+        streamPosition += n;
+
+        if (headFill == headSize)
+        {
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                const auto irChannel = ir != nullptr ? (size_t) juce::jmin (ch, ir->numChannels - 1) : 0;
+
+                headConvolver[(size_t) ch].process (headInput[(size_t) ch].data(),
+                                                    ir != nullptr ? ir->head[irChannel].data() : nullptr,
+                                                    ir != nullptr ? ir->numHeadPartitions : 0,
+                                                    headOutput[(size_t) ch].data());
+            }
+
+            headFill = 0;
+        }
+
+        if (tailFill == tailSize)
+        {
+            chunksSubmitted.fetch_add (1, std::memory_order_release);
+            tailFill = 0;
+
+            // Once per tail partition. A signal sent while the tail thread is busy is kept for its next wait.
+            notify();
+        }
+    }
+}
+
+void ConvolutionData::resetAll()
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        headConvolver[(size_t) ch].reset();
+        tailConvolver[(size_t) ch].reset();
+        std::fill (headOutput[(size_t) ch].begin(), headOutput[(size_t) ch].end(), 0.0f);
+        std::fill (tailRing[(size_t) ch].begin(), tailRing[(size_t) ch].end(), 0.0f);
+    }
+
+    headFill = 0;
+    tailFill = 0;
+    streamPosition = 0;
+    chunksSubmitted.store (0);
+    chunksDone.store (0);
+
+    dryGain.setCurrentAndTargetValue (dryGain.getTargetValue());
+    wetGain.setCurrentAndTargetValue (wetGain.getTargetValue());
+}
+
+void ConvolutionData::run()
+{
+    while (! threadShouldExit())
+    {
+        const auto submitted = chunksSubmitted.load (std::memory_order_acquire);
+        auto done = chunksDone.load (std::memory_order_relaxed);
+
+        // Too far behind: the input of the oldest chunks is already being overwritten
+        while (submitted - done >= numTailSlots)
+        {
+            clearTailChunk (done);
+            chunksDone.store (++done, std::memory_order_release);
+        }
+
+        while (done < submitted && ! threadShouldExit())
+        {
+            processTailChunk (done);
+            chunksDone.store (++done, std::memory_order_release);
+        }
+
+        // This thread never holds on to a replaced impulse response, so it can free them
+        impulse.collectGarbage();
+
+        // Sleeps until processNextBlock() hands over a partition, so an instance that isn't processed costs nothing
+        wait (-1);
+    }
+}
+
+void ConvolutionData::processTailChunk (const juce::int64 chunk)
+{
+    const auto* ir = tailImpulse.load (std::memory_order_acquire);
+    const auto slot = (size_t) (chunk % numTailSlots);
+    const auto ringOffset = (int) (((chunk + 2) * tailSize) % tailRingSize);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto hasTail = ir != nullptr && ir->numTailPartitions > 0;
+        const auto irChannel = hasTail ? (size_t) juce::jmin (ch, ir->numChannels - 1) : 0;
+
+        tailConvolver[(size_t) ch].process (tailInput[slot][(size_t) ch].data(),
+                                            hasTail ? ir->tail[irChannel].data() : nullptr,
+                                            hasTail ? ir->numTailPartitions : 0,
+                                            tailRing[(size_t) ch].data() + ringOffset);
+    }
+}
+
+void ConvolutionData::clearTailChunk (const juce::int64 chunk)
+{
+    const auto ringOffset = (int) (((chunk + 2) * tailSize) % tailRingSize);
+    std::fill (tailScratch.begin(), tailScratch.end(), 0.0f);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        // Keeps the frequency-domain delay line in step with the timeline
+        tailConvolver[(size_t) ch].process (tailScratch.data(), nullptr, 0, tailRing[(size_t) ch].data() + ringOffset);
+    }
+}
+
+std::unique_ptr<ConvolutionData::ImpulseResponse> ConvolutionData::createImpulseResponse (const juce::File& file, const double sampleRate)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return {};
+
+    const auto channels = juce::jmin (maxChannels, (int) reader->numChannels);
+    const auto sourceLength = (int) juce::jmin (reader->lengthInSamples, (juce::int64) std::ceil (maxImpulseSeconds * reader->sampleRate));
+
+    juce::AudioBuffer<float> source (channels, sourceLength);
+    reader->read (&source, 0, sourceLength, 0, true, true);
+
+    const auto ratio = reader->sampleRate / sampleRate;
+
+    if (std::abs (ratio - 1.0) > 1.0e-6)
+    {
+        const auto length = (int) std::floor ((sourceLength - 4) / ratio);
+
+        if (length <= 0)
+            return {};
+
+        juce::AudioBuffer<float> resampled (channels, length);
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            juce::LagrangeInterpolator interpolator;
+            interpolator.process (ratio, source.getReadPointer (ch), resampled.getWritePointer (ch), length);
+        }
+
+        source = std::move (resampled);
+    }
+
+    auto energy = 0.0;
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const auto* samples = source.getReadPointer (ch);
+
+        for (int s = 0; s < source.getNumSamples(); ++s)
+            energy += samples[s] * samples[s];
+    }
+
+    if (energy <= 0.0)
+        return {};
+
+    source.applyGain (impulseGain / (float) std::sqrt (energy / channels));
+
+    const auto length = source.getNumSamples();
+    const auto headSamples = juce::jmin (length, headLength);
+    const auto tailSamples = juce::jmax (0, length - headLength);
+
+    auto ir = std::make_unique<ImpulseResponse>();
+    ir->numChannels = channels;
+    ir->numHeadPartitions = PartitionedConvolver::getNumPartitions (headSamples, headSize);
+    ir->numTailPartitions = PartitionedConvolver::getNumPartitions (tailSamples, tailSize);
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        ir->head[(size_t) ch] = PartitionedConvolver::transformPartitions (source.getReadPointer (ch), headSamples, headSize);
+
+        if (tailSamples > 0)
+            ir->tail[(size_t) ch] = PartitionedConvolver::transformPartitions (source.getReadPointer (ch, headLength), tailSamples, tailSize);
+    }
+
+    return ir;
+}
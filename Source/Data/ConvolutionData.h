@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    ConvolutionData.h
+    Created: 19 Oct 2026 1:37:50pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AtomicSwap.h"
+
+// Uniformly partitioned overlap-save convolution for one channel, with a
+// frequency-domain delay line holding the spectra of past input partitions.
+class PartitionedConvolver
+{
+public:
+    void prepare (const int partitionSize, const int maxPartitions);
+    void process (const float* input, const float* partitionSpectra, const int numPartitions, float* output);
+    void reset();
+
+    // Spectra of an impulse response cut into partitionSize pieces, numBins complex values each
+    static std::vector<float> transformPartitions (const float* impulse, const int numSamples, const int partitionSize);
+    static int getNumPartitions (const int numSamples, const int partitionSize) { return (numSamples + partitionSize - 1) / partitionSize; }
+
+private:
+    int size { 0 };
+    int numBins { 0 };
+    int maxPartitions { 0 };
+    int fdlIndex { 0 };
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> previousInput;
+    std::vector<float> fftBuffer;
+    std::vector<float> frequencyDelayLine;
+};
+
+// Convolution reverb engine. A short head partition runs on the audio thread,
+// the long tail partitions run on a background thread, and impulse responses are
+// decoded, resampled and transformed on a loader thread before being swapped in.
+class ConvolutionData : private juce::Thread
+{
+public:
+    // 64 sample head partitions keep the wet path latency at 64 samples; the
+    // tail starts two tail partitions in, which is the time the background
+    // thread gets to finish each tail partition.
+    static constexpr int headSize { 64 };
+    static constexpr int tailSize { 2048 };
+    static constexpr int headLength { 2 * tailSize };
+
+    ConvolutionData();
+    ~ConvolutionData() override;
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
+    void loadImpulseResponse (const juce::File& file);
+    void setParams (const float dry, const float wet);
+    void processNextBlock (juce::AudioBuffer<float>& buffer);
+
+private:
+    struct ImpulseResponse
+    {
+        int numChannels { 0 };
+        int numHeadPartitions { 0 };
+        int numTailPartitions { 0 };
+        std::array<std::vector<float>, 2> head;
+        std::array<std::vector<float>, 2> tail;
+    };
+
+    static constexpr int numTailSlots { 4 };
+    static constexpr int tailRingSize { 4 * tailSize };
+    static constexpr double maxImpulseSeconds { 10.0 };
+    static constexpr int maxChannels { 2 };
+
+    void run() override;
+    void resetAll();
+    void processTailChunk (const juce::int64 chunk);
+    void clearTailChunk (const juce::int64 chunk);
+    std::unique_ptr<ImpulseResponse> createImpulseResponse (const juce::File& file, const double sampleRate);
+
+    double currentSampleRate { 0.0 };
+    int numChannels { 0 };
+
+    AtomicSwap<ImpulseResponse> impulse;
+    std::atomic<ImpulseResponse*> tailImpulse { nullptr };
+
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool loaderPool { 1 };
+    juce::File impulseFile;
+
+    // Head, processed in the audio callback
+    std::array<PartitionedConvolver, maxChannels> headConvolver;
+    std::array<std::vector<float>, maxChannels> headInput;
+    std::array<std::vector<float>, maxChannels> headOutput;
+    int headFill { 0 };
+
+    // Tail, filled by the audio callback and processed by run()
+    std::array<PartitionedConvolver, maxChannels> tailConvolver;
+    std::array<std::array<std::vector<float>, maxChannels>, numTailSlots> tailInput;
+    std::array<std::vector<float>, maxChannels> tailRing;
+    std::vector<float> tailScratch;
+    int tailFill { 0 };
+    juce::int64 streamPosition { 0 };
+    std::atomic<juce::int64> chunksSubmitted { 0 };
+    std::atomic<juce::int64> chunksDone { 0 };
+
+    juce::SmoothedValue<float> dryGain { 1.0f };
+    juce::SmoothedValue<float> wetGain { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionData)
+};
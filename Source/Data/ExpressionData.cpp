@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    ExpressionData.cpp
+    Created: 19 Oct 2026 8:04:51pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "ExpressionData.h"
+
+void ExpressionData::prepareToPlay (double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    channelPressure.fill (0.0f);
+    channelSlide.fill (0.0f);
+    pressure.fill (0.0f);
+    pressureTarget.fill (0.0f);
+    slide.fill (0.0f);
+    slideTarget.fill (0.0f);
+    lowerMasterPitchBend = 0.0f;
+    upperMasterPitchBend = 0.0f;
+}
+
+void ExpressionData::setParams (const bool mpeEnabled)
+{
+    if (mpeEnabled == mpeOn)
+        return;
+
+    mpeOn = mpeEnabled;
+    zoneLayout.clearAllZones();
+
+    // Hosts that never send a configuration message still get the usual layout
+    if (mpeOn)
+        zoneLayout.setLowerZone (numChannels - 1);
+}
+
+void ExpressionData::processMidi (const juce::MidiBuffer& midiMessages)
+{
+    for (const auto metadata : midiMessages)
+    {
+        const auto message = metadata.getMessage();
+        const auto channel = message.getChannel();
+
+        if (mpeOn)
+            zoneLayout.processNextMidiEvent (message);
+
+        if (message.isChannelPressure())
+        {
+            channelPressure[(size_t) channel] = (float) message.getChannelPressureValue() / 127.0f;
+        }
+        else if (message.isControllerOfType (slideController))
+        {
+            channelSlide[(size_t) channel] = (float) (message.getControllerValue() - 64) / 64.0f;
+        }
+        else if (message.isPitchWheel() && isMasterChannel (channel))
+        {
+            const auto lower = zoneLayout.getLowerZone();
+            const auto bend = (float) (message.getPitchWheelValue() - 8192) / 8192.0f;
+
+            if (lower.isActive() && lower.getMasterChannel() == channel)
+                lowerMasterPitchBend = bend * (float) lower.masterPitchbendRange;
+            else
+                upperMasterPitchBend = bend * (float) zoneLayout.getUpperZone().masterPitchbendRange;
+        }
+    }
+}
+
+void ExpressionData::advance (const int numSamples)
+{
+    // One pole per dimension, the same coefficient for every voice
+    const auto coefficient = (float) (1.0 - std::exp (-numSamples / (smoothingSeconds * currentSampleRate)));
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        pressure[(size_t) v] += coefficient * (pressureTarget[(size_t) v] - pressure[(size_t) v]);
+        slide[(size_t) v] += coefficient * (slideTarget[(size_t) v] - slide[(size_t) v]);
+    }
+}
+
+bool ExpressionData::appliesToChannel (const int midiChannel) const noexcept
+{
+    if (! zoneLayout.isActive())
+        return true;
+
+    return zoneLayout.getLowerZone().isUsing (midiChannel) || zoneLayout.getUpperZone().isUsing (midiChannel);
+}
+
+bool ExpressionData::isMasterChannel (const int midiChannel) const noexcept
+{
+    const auto lower = zoneLayout.getLowerZone();
+    const auto upper = zoneLayout.getUpperZone();
+
+    return (lower.isActive() && lower.getMasterChannel() == midiChannel)
+        || (upper.isActive() && upper.getMasterChannel() == midiChannel);
+}
+
+float ExpressionData::getPitchBendRange (const int midiChannel) const noexcept
+{
+    const auto lower = zoneLayout.getLowerZone();
+    const auto upper = zoneLayout.getUpperZone();
+
+    if (lower.isActive() && lower.isUsingChannelAsMemberChannel (midiChannel))
+        return (float) lower.perNotePitchbendRange;
+
+    if (upper.isActive() && upper.isUsingChannelAsMemberChannel (midiChannel))
+        return (float) upper.perNotePitchbendRange;
+
+    return defaultPitchBendRange;
+}
+
+float ExpressionData::getMasterPitchBend (const int midiChannel) const noexcept
+{
+    const auto lower = zoneLayout.getLowerZone();
+    const auto upper = zoneLayout.getUpperZone();
+
+    if (lower.isActive() && lower.isUsing (midiChannel))
+        return lowerMasterPitchBend;
+
+    if (upper.isActive() && upper.isUsing (midiChannel))
+        return upperMasterPitchBend;
+
+    return 0.0f;
+}
+
+void ExpressionData::startVoice (const int voice, const int midiChannel)
+{
+    jassert (juce::isPositiveAndBelow (voice, maxVoices));
+
+    // Expression sent ahead of the note applies from its first sample
+    const auto channel = (size_t) juce::jlimit (1, numChannels, midiChannel);
+    pressure[(size_t) voice] = pressureTarget[(size_t) voice] = channelPressure[channel];
+    slide[(size_t) voice] = slideTarget[(size_t) voice] = channelSlide[channel];
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    ExpressionData.h
+    Created: 19 Oct 2026 8:04:51pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Per-note expression for MPE. The zone layout is followed from MPE
+// configuration messages, or a lower zone over all 15 member channels is
+// used when MPE is switched on without one. Each voice's pressure and slide
+// live in flat arrays indexed by voice; an incoming message only stores a
+// target, and all voices are smoothed together once per block.
+class ExpressionData
+{
+public:
+    static constexpr int maxVoices { 16 };
+
+    void prepareToPlay (double sampleRate);
+    void setParams (const bool mpeEnabled);
+
+    // Audio thread, before the synth renders. Remembers each channel's last
+    // pressure and slide so a note starts from the values sent ahead of it.
+    void processMidi (const juce::MidiBuffer& midiMessages);
+
+    // Audio thread, once per block
+    void advance (const int numSamples);
+
+    bool appliesToChannel (const int midiChannel) const noexcept;
+    bool isMasterChannel (const int midiChannel) const noexcept;
+    float getPitchBendRange (const int midiChannel) const noexcept;
+
+    // Bend of the master channel of the zone the channel belongs to, in semitones
+    float getMasterPitchBend (const int midiChannel) const noexcept;
+
+    // Voice side; constant time whatever the partial count
+    void startVoice (const int voice, const int midiChannel);
+    void setPressure (const int voice, const float pressure) noexcept { pressureTarget[(size_t) voice] = pressure; }
+    void setSlide (const int voice, const float slide) noexcept { slideTarget[(size_t) voice] = slide; }
+
+    // 0 to 1
+    float getPressure (const int voice) const noexcept { return pressure[(size_t) voice]; }
+
+    // -1 to 1, centred on the MPE default of 64
+    float getSlide (const int voice) const noexcept { return slide[(size_t) voice]; }
+
+    static constexpr int slideController { 74 };
+
+private:
+    static constexpr int numChannels { 16 };
+    static constexpr double smoothingSeconds { 0.01 };
+    static constexpr float defaultPitchBendRange { 2.0f };
+
+    double currentSampleRate { 44100.0 };
+    bool mpeOn { false };
+    juce::MPEZoneLayout zoneLayout;
+    float lowerMasterPitchBend { 0.0f };
+    float upperMasterPitchBend { 0.0f };
+
+    // Last value seen on each channel, index 0 unused
+    std::array<float, numChannels + 1> channelPressure {};
+    std::array<float, numChannels + 1> channelSlide {};
+
+    alignas (16) std::array<float, maxVoices> pressure {};
+    alignas (16) std::array<float, maxVoices> pressureTarget {};
+    alignas (16) std::array<float, maxVoices> slide {};
+    alignas (16) std::array<float, maxVoices> slideTarget {};
+};
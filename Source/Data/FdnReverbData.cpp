@@ -0,0 +1,299 @@
+/*
+  ==============================================================================
+
+    FdnReverbData.cpp
+    Created: 19 Oct 2026 10:04:12am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "FdnReverbData.h"
+
+namespace
+{
+    constexpr float shortestDelayMs { 29.0f };
+    constexpr float longestDelayMs { 89.0f };
+    constexpr float slowestModHz { 0.13f };
+    constexpr float fastestModHz { 0.87f };
+
+    // Same scaling as juce::Reverb so switching engine keeps the dry level
+    constexpr float dryScaleFactor { 2.0f };
+    constexpr float wetScaleFactor { 3.0f };
+    constexpr float inputScale { 0.25f };
+
+    bool isPrime (int n)
+    {
+        if (n < 2)
+            return false;
+
+        for (int d = 2; d * d <= n; ++d)
+            if (n % d == 0)
+                return false;
+
+        return true;
+    }
+
+    int nextPrime (int n)
+    {
+        while (! isPrime (n))
+            ++n;
+
+        return n;
+    }
+}
+
+void FdnReverbData::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+{
+    currentSampleRate = sampleRate;
+
+    delayLength = (int) std::ceil (longestDelayMs * 0.001 * sampleRate * 1.1) + (int) maxModDepthSamples + 2;
+    delayMemory.assign ((size_t) (delayLength * maxVecs), Vec::expand (0.0f));
+
+    dryGain.reset (sampleRate, 0.05);
+    wetGain1.reset (sampleRate, 0.05);
+    wetGain2.reset (sampleRate, 0.05);
+
+    currentQuality = -1;
+    setQuality (standard);
+}
+
+void FdnReverbData::setParams (const float size, const float damping, const float width, const float dry, const float wet, const float freeze, const int quality)
+{
+    setQuality (quality);
+
+    const auto newDecay = 0.3f * std::pow (40.0f, size);
+    const auto newFrozen = freeze >= 0.5f;
+
+    if (newDecay != decaySeconds || newFrozen != frozen)
+    {
+        decaySeconds = newDecay;
+        frozen = newFrozen;
+        updateLineCoefficients();
+    }
+
+    dampingCoefficient = damping * 0.8f;
+
+    const auto wetLevel = wet * wetScaleFactor;
+    dryGain.setTargetValue (dry * dryScaleFactor);
+    wetGain1.setTargetValue (0.5f * wetLevel * (1.0f + width));
+    wetGain2.setTargetValue (0.5f * wetLevel * (1.0f - width));
+}
+
+void FdnReverbData::setQuality (const int quality)
+{
+    if (quality == currentQuality)
+        return;
+
+    currentQuality = quality;
+    numLines = quality >= high ? 16 : 8;
+    isModulated = quality == standard || quality == ultra;
+
+    const auto twoPi = juce::MathConstants<float>::twoPi;
+    const auto lineScale = 1.0f / std::sqrt ((float) numLines);
+
+    alignas (64) std::array<float, maxLines> inL {}, inR {}, outL {}, outR {}, cosPhase {}, sinPhase {}, rotCos {}, rotSin {};
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        const auto position = (float) i / (float) (numLines - 1);
+
+        // Geometrically spaced, mutually prime lengths keep the echo density even
+        const auto ms = shortestDelayMs * std::pow (longestDelayMs / shortestDelayMs, position);
+        delaySamples[(size_t) i] = nextPrime ((int) (ms * 0.001f * (float) currentSampleRate));
+
+        // Orthogonal sign patterns decorrelate the two inputs and outputs
+        inL[(size_t) i]  = ((i & 1) ? -lineScale : lineScale);
+        inR[(size_t) i]  = ((i & 2) ? -lineScale : lineScale);
+        outL[(size_t) i] = ((i & 4) ? -lineScale : lineScale);
+        outR[(size_t) i] = (((i >> 1) ^ i) & 1) ? -lineScale : lineScale;
+
+        const auto modHz = slowestModHz + (fastestModHz - slowestModHz) * position;
+        const auto omega = twoPi * modHz / (float) currentSampleRate;
+        cosPhase[(size_t) i] = std::cos (twoPi * position);
+        sinPhase[(size_t) i] = std::sin (twoPi * position);
+        rotCos[(size_t) i] = std::cos (omega);
+        rotSin[(size_t) i] = std::sin (omega);
+    }
+
+    for (int v = 0; v < maxVecs; ++v)
+    {
+        inputLeft[(size_t) v]   = Vec::fromRawArray (inL.data() + v * vecSize);
+        inputRight[(size_t) v]  = Vec::fromRawArray (inR.data() + v * vecSize);
+        outputLeft[(size_t) v]  = Vec::fromRawArray (outL.data() + v * vecSize);
+        outputRight[(size_t) v] = Vec::fromRawArray (outR.data() + v * vecSize);
+        modCos[(size_t) v]      = Vec::fromRawArray (cosPhase.data() + v * vecSize);
+        modSin[(size_t) v]      = Vec::fromRawArray (sinPhase.data() + v * vecSize);
+        modRotCos[(size_t) v]   = Vec::fromRawArray (rotCos.data() + v * vecSize);
+        modRotSin[(size_t) v]   = Vec::fromRawArray (rotSin.data() + v * vecSize);
+    }
+
+    // The frame stride changes with the line count, so the old tail is meaningless
+    resetAll();
+    updateLineCoefficients();
+}
+
+void FdnReverbData::updateLineCoefficients()
+{
+    alignas (64) std::array<float, maxLines> gains {};
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        // -60 dB after decaySeconds, regardless of the line length
+        gains[(size_t) i] = frozen ? 1.0f
+                                   : std::pow (10.0f, -3.0f * (float) delaySamples[(size_t) i] / (decaySeconds * (float) currentSampleRate));
+    }
+
+    for (int v = 0; v < maxVecs; ++v)
+        feedbackGain[(size_t) v] = Vec::fromRawArray (gains.data() + v * vecSize);
+}
+
+void FdnReverbData::processNextBlock (juce::AudioBuffer<float>& buffer)
+{
+    if (buffer.getNumChannels() == 0 || delayMemory.empty())
+        return;
+
+    auto* left = buffer.getWritePointer (0);
+    auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer (1) : nullptr;
+
+    if (numLines == 16)
+        processLines<16> (left, right, buffer.getNumSamples());
+    else
+        processLines<8> (left, right, buffer.getNumSamples());
+}
+
+template <int lines>
+void FdnReverbData::processLines (float* left, float* right, int numSamples)
+{
+    constexpr int numVecs = lines / vecSize;
+
+    auto* memory = reinterpret_cast<float*> (delayMemory.data());
+    const auto householder = Vec::expand (-2.0f / (float) lines);
+    const auto damp = Vec::expand (frozen ? 0.0f : dampingCoefficient);
+    const auto modDepth = Vec::expand (maxModDepthSamples);
+    const auto inputGain = frozen ? 0.0f : inputScale;
+
+    alignas (64) std::array<float, maxLines> modOffsets {};
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        const auto dryLeft = left[s];
+        const auto dryRight = right != nullptr ? right[s] : dryLeft;
+
+        // Gather one output sample from every line
+        if (isModulated)
+        {
+            for (int v = 0; v < numVecs; ++v)
+            {
+                const auto c = modCos[(size_t) v];
+                const auto sn = modSin[(size_t) v];
+                modCos[(size_t) v] = c * modRotCos[(size_t) v] - sn * modRotSin[(size_t) v];
+                modSin[(size_t) v] = sn * modRotCos[(size_t) v] + c * modRotSin[(size_t) v];
+                (modSin[(size_t) v] * modDepth).copyToRawArray (modOffsets.data() + v * vecSize);
+            }
+
+            for (int i = 0; i < lines; ++i)
+            {
+                auto readPos = (float) writeIndex - ((float) delaySamples[(size_t) i] + modOffsets[(size_t) i]);
+
+                if (readPos < 0.0f)
+                    readPos += (float) delayLength;
+
+                const auto index0 = (int) readPos;
+                const auto index1 = index0 + 1 == delayLength ? 0 : index0 + 1;
+                const auto frac = readPos - (float) index0;
+                const auto a = memory[index0 * lines + i];
+                const auto b = memory[index1 * lines + i];
+
+                taps[(size_t) i] = a + frac * (b - a);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < lines; ++i)
+            {
+                auto readIndex = writeIndex - delaySamples[(size_t) i];
+
+                if (readIndex < 0)
+                    readIndex += delayLength;
+
+                taps[(size_t) i] = memory[readIndex * lines + i];
+            }
+        }
+
+        // Damping, feedback gain, output taps and the Householder sum, one register at a time
+        std::array<Vec, numVecs> feedback;
+        auto accLeft = Vec::expand (0.0f);
+        auto accRight = Vec::expand (0.0f);
+        auto total = Vec::expand (0.0f);
+
+        for (int v = 0; v < numVecs; ++v)
+        {
+            const auto x = Vec::fromRawArray (taps.data() + v * vecSize);
+            auto& lp = dampingState[(size_t) v];
+
+            lp = x + damp * (lp - x);
+            accLeft += lp * outputLeft[(size_t) v];
+            accRight += lp * outputRight[(size_t) v];
+
+            feedback[(size_t) v] = lp * feedbackGain[(size_t) v];
+            total += feedback[(size_t) v];
+        }
+
+        // Householder reflection: y = x - 2/N * sum(x), lossless and O(N)
+        const auto reflection = Vec::expand (total.sum()) * householder;
+        const auto inLeft = Vec::expand (dryLeft * inputGain);
+        const auto inRight = Vec::expand (dryRight * inputGain);
+        auto* frame = memory + writeIndex * lines;
+
+        for (int v = 0; v < numVecs; ++v)
+        {
+            const auto next = feedback[(size_t) v] + reflection
+                            + inputLeft[(size_t) v] * inLeft
+                            + inputRight[(size_t) v] * inRight;
+
+            next.copyToRawArray (frame + v * vecSize);
+        }
+
+        if (++writeIndex == delayLength)
+            writeIndex = 0;
+
+        const auto wetLeft = accLeft.sum();
+        const auto wetRight = accRight.sum();
+        const auto dry = dryGain.getNextValue();
+        const auto w1 = wetGain1.getNextValue();
+        const auto w2 = wetGain2.getNextValue();
+
+        left[s] = wetLeft * w1 + wetRight * w2 + dryLeft * dry;
+
+        if (right != nullptr)
+            right[s] = wetRight * w1 + wetLeft * w2 + dryRight * dry;
+    }
+
+    // Keep the rotating LFO phasors on the unit circle
+    if (isModulated)
+    {
+        for (int v = 0; v < numVecs; ++v)
+        {
+            for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+            {
+                const auto c = modCos[(size_t) v].get (lane);
+                const auto sn = modSin[(size_t) v].get (lane);
+                const auto norm = 1.0f / std::sqrt (c * c + sn * sn);
+                modCos[(size_t) v].set (lane, c * norm);
+                modSin[(size_t) v].set (lane, sn * norm);
+            }
+        }
+    }
+}
+
+void FdnReverbData::resetAll()
+{
+    std::fill (delayMemory.begin(), delayMemory.end(), Vec::expand (0.0f));
+    std::fill (dampingState.begin(), dampingState.end(), Vec::expand (0.0f));
+    writeIndex = 0;
+
+    dryGain.setCurrentAndTargetValue (dryGain.getTargetValue());
+    wetGain1.setCurrentAndTargetValue (wetGain1.getTargetValue());
+    wetGain2.setCurrentAndTargetValue (wetGain2.getTargetValue());
+}
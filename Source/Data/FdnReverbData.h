@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    FdnReverbData.h
+    Created: 19 Oct 2026 10:04:12am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Feedback delay network reverb, used as an alternative to juce::dsp::Reverb.
+// The delay lines are stored interleaved (one frame holds one sample of every
+// line) so that writing, damping, feedback and mixing of 8 or 16 lines are done
+// with juce::dsp::SIMDRegister operations instead of one line at a time.
+class FdnReverbData
+{
+public:
+    enum Quality
+    {
+        eco = 0,        // 8 lines, fixed delays
+        standard,       // 8 lines, modulated delays
+        high,           // 16 lines, fixed delays
+        ultra           // 16 lines, modulated delays
+    };
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
+    void setParams (const float size, const float damping, const float width, const float dry, const float wet, const float freeze, const int quality);
+    void processNextBlock (juce::AudioBuffer<float>& buffer);
+    void resetAll();
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxLines { 16 };
+    static constexpr int vecSize { (int) Vec::SIMDNumElements };
+    static constexpr int maxVecs { maxLines / vecSize };
+    static constexpr float maxModDepthSamples { 12.0f };
+
+    static_assert (maxLines % vecSize == 0, "Line count must be a multiple of the SIMD width");
+
+    template <int lines>
+    void processLines (float* left, float* right, int numSamples);
+
+    void setQuality (const int quality);
+    void updateLineCoefficients();
+
+    double currentSampleRate { 44100.0 };
+    int numLines { 8 };
+    int currentQuality { -1 };
+    bool isModulated { false };
+
+    // Interleaved delay memory: sample n of line i lives at frame n * numLines + i
+    std::vector<Vec> delayMemory;
+    int delayLength { 0 };
+    int writeIndex { 0 };
+
+    std::array<int, maxLines> delaySamples {};
+    std::array<Vec, maxVecs> feedbackGain {};
+    std::array<Vec, maxVecs> dampingState {};
+    std::array<Vec, maxVecs> inputLeft {};
+    std::array<Vec, maxVecs> inputRight {};
+    std::array<Vec, maxVecs> outputLeft {};
+    std::array<Vec, maxVecs> outputRight {};
+
+    // Per line quadrature LFOs for delay modulation, rotated once per sample
+    std::array<Vec, maxVecs> modCos {};
+    std::array<Vec, maxVecs> modSin {};
+    std::array<Vec, maxVecs> modRotCos {};
+    std::array<Vec, maxVecs> modRotSin {};
+
+    alignas (64) std::array<float, maxLines> taps {};
+
+    float decaySeconds { 1.0f };
+    float dampingCoefficient { 0.0f };
+    bool frozen { false };
+
+    juce::SmoothedValue<float> dryGain { 1.0f };
+    juce::SmoothedValue<float> wetGain1 { 0.0f };
+    juce::SmoothedValue<float> wetGain2 { 0.0f };
+};
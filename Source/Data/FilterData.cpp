@@ -10,70 +10,81 @@
 
 #include "FilterData.h"
 
-FilterData::FilterData()
+template <typename SampleType>
+FilterData<SampleType>::FilterData()
 {
-    setType (juce::dsp::StateVariableTPTFilterType::lowpass);
+    this->setType (juce::dsp::StateVariableTPTFilterType::lowpass);
 }
 
-void FilterData::setParams (const int filterType, const float filterCutoff, const float filterResonance)
+template <typename SampleType>
+void FilterData<SampleType>::setParams (const int filterType, const float filterCutoff, const float filterResonance)
 {
     selectFilterType (filterType);
-    setCutoffFrequency (filterCutoff);
-    setResonance (filterResonance);
+    this->setCutoffFrequency ((SampleType) filterCutoff);
+    this->setResonance ((SampleType) filterResonance);
 }
 
-void FilterData::setLfoParams (const float freq, const float depth)
+template <typename SampleType>
+void FilterData<SampleType>::setLfoParams (const float freq, const float depth)
 {
 //    lfoGain = juce::Decibels::gainToDecibels (depth);
 //    lfo.setFrequency (freq);
 }
 
-void FilterData::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+template <typename SampleType>
+void FilterData<SampleType>::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
 {
     resetAll();
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
     spec.sampleRate = sampleRate;
     spec.numChannels = outputChannels;
-    prepare (spec);
+    this->prepare (spec);
 }
 
 
-void FilterData::selectFilterType (const int filterType)
+template <typename SampleType>
+void FilterData<SampleType>::selectFilterType (const int filterType)
 {    
     switch (filterType)
     {
         case 0:
-            setType (juce::dsp::StateVariableTPTFilterType::lowpass);
+            this->setType (juce::dsp::StateVariableTPTFilterType::lowpass);
             break;
             
         case 1:
-            setType (juce::dsp::StateVariableTPTFilterType::bandpass);
+            this->setType (juce::dsp::StateVariableTPTFilterType::bandpass);
             break;
             
         case 2:
-            setType (juce::dsp::StateVariableTPTFilterType::highpass);
+            this->setType (juce::dsp::StateVariableTPTFilterType::highpass);
             break;
             
         default:
-            setType (juce::dsp::StateVariableTPTFilterType::lowpass);
+            this->setType (juce::dsp::StateVariableTPTFilterType::lowpass);
             break;
     }
 }
 
-void FilterData::processNextBlock(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void FilterData<SampleType>::processNextBlock(juce::AudioBuffer<SampleType>& buffer)
 {
-    juce::dsp::AudioBlock<float> block { buffer };
-    process (juce::dsp::ProcessContextReplacing<float>(block));
+    juce::dsp::AudioBlock<SampleType> block { buffer };
+    this->process (juce::dsp::ProcessContextReplacing<SampleType>(block));
 }
 
-float FilterData::processNextSample (int channel, float inputValue)
+template <typename SampleType>
+SampleType FilterData<SampleType>::processNextSample (int channel, SampleType inputValue)
 {
-    return processSample (channel, inputValue);
+    return this->processSample (channel, inputValue);
 }
 
-void FilterData::resetAll()
+template <typename SampleType>
+void FilterData<SampleType>::resetAll()
 {
-    reset();
+    this->reset();
     lfo.reset();
 }
+
+template class FilterData<float>;
+template class FilterData<double>;
@@ -14,15 +14,16 @@
 #include <JuceHeader.h>
 
 
-class FilterData : public juce::dsp::StateVariableTPTFilter<float>
+template <typename SampleType>
+class FilterData : public juce::dsp::StateVariableTPTFilter<SampleType>
 {
 public:
     FilterData();
     void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
     void setParams (const int filterType, const float filterCutoff, const float filterResonance);
     void setLfoParams (const float freq, const float depth);
-    void processNextBlock (juce::AudioBuffer<float>& buffer);
-    float processNextSample (int channel, float inputValue);
+    void processNextBlock (juce::AudioBuffer<SampleType>& buffer);
+    SampleType processNextSample (int channel, SampleType inputValue);
     void resetAll();
     
 private:
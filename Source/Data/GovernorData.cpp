@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    GovernorData.cpp
+    Created: 20 Oct 2026 12:07:18am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "GovernorData.h"
+
+juce::StringArray GovernorData::getQualityNames()
+{
+    return { "Full", "Quiet Partials Dropped", "Oversampling Lowered", "Unison Reduced", "Releases Shortened" };
+}
+
+void GovernorData::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    loadMeasurer.reset (sampleRate, samplesPerBlock);
+    stepDownSamples = (int) (stepDownSeconds * sampleRate);
+    stepUpSamples = (int) (stepUpSeconds * sampleRate);
+    samplesOver = 0;
+    samplesUnder = 0;
+    lastXRunCount = loadMeasurer.getXRunCount();
+    quality.store (full, std::memory_order_relaxed);
+}
+
+void GovernorData::update (const int numSamples) noexcept
+{
+    const auto load = loadMeasurer.getLoadAsProportion();
+    const auto xRunCount = loadMeasurer.getXRunCount();
+    const auto overran = xRunCount != lastXRunCount;
+    lastXRunCount = xRunCount;
+
+    auto level = quality.load (std::memory_order_relaxed);
+
+    if (overran || load > stepDownLoad)
+    {
+        samplesUnder = 0;
+        samplesOver += numSamples;
+
+        // An overrun has already cost a buffer, so it does not wait
+        if (overran || samplesOver >= stepDownSamples)
+        {
+            level = juce::jmin (level + 1, numQualities - 1);
+            samplesOver = 0;
+        }
+    }
+    else if (load < stepUpLoad)
+    {
+        samplesOver = 0;
+        samplesUnder += numSamples;
+
+        if (samplesUnder >= stepUpSamples)
+        {
+            level = juce::jmax (level - 1, (int) full);
+            samplesUnder = 0;
+        }
+    }
+    else
+    {
+        samplesOver = 0;
+        samplesUnder = 0;
+    }
+
+    quality.store (level, std::memory_order_relaxed);
+}
+
+void GovernorData::holdFullQuality() noexcept
+{
+    samplesOver = 0;
+    samplesUnder = 0;
+    lastXRunCount = loadMeasurer.getXRunCount();
+    quality.store (full, std::memory_order_relaxed);
+}
+
+float GovernorData::getPartialFloor() const noexcept
+{
+    // -60 dB
+    return getQuality() >= dropQuietPartials ? 0.001f : 0.0f;
+}
+
+int GovernorData::limitOversampling (const int order) const noexcept
+{
+    return getQuality() >= lowerOversampling ? juce::jmax (0, order - 1) : order;
+}
+
+int GovernorData::limitUnison (const int numVoices) const noexcept
+{
+    return getQuality() >= reduceUnison ? juce::jmax (1, numVoices / 2) : numVoices;
+}
+
+float GovernorData::getReleaseFloor() const noexcept
+{
+    // -40 dB
+    return getQuality() >= endReleasesEarly ? 0.01f : 0.0f;
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    GovernorData.h
+    Created: 20 Oct 2026 12:07:18am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Keeps the synth inside its real-time budget by giving up quality before it
+// gives up a buffer. Every block is timed against its deadline with
+// juce::AudioProcessLoadMeasurer. Load held above the upper threshold, or a
+// block that overran, steps the quality down a level; load held below the
+// lower threshold steps it back up. The gap between the thresholds, and the
+// much longer hold before stepping up, keep it from flapping.
+//
+// Each level keeps the savings of the ones above it, cheapest to hear first:
+// partials under -60 dB are dropped, then oversampling goes down a factor,
+// then unison loses half its copies, and last, released notes are ended once
+// they have faded by 40 dB.
+class GovernorData
+{
+public:
+    enum Quality
+    {
+        full = 0,
+        dropQuietPartials,
+        lowerOversampling,
+        reduceUnison,
+        endReleasesEarly,
+        numQualities
+    };
+
+    static juce::StringArray getQualityNames();
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock);
+
+    // For a ScopedTimer around the whole block
+    juce::AudioProcessLoadMeasurer& getLoadMeasurer() noexcept { return loadMeasurer; }
+
+    // Audio thread, once per block, before the settings below are read
+    void update (const int numSamples) noexcept;
+
+    // Audio thread, in place of update() while rendering offline, where there
+    // is no deadline to keep. Quality returns to full and the load history is
+    // dropped, so a return to real time starts counting afresh.
+    void holdFullQuality() noexcept;
+
+    // Any thread
+    int getQuality() const noexcept { return quality.load (std::memory_order_relaxed); }
+    float getLoad() const { return (float) loadMeasurer.getLoadAsProportion(); }
+
+    // The settings at the current quality, from the ones asked for
+    float getPartialFloor() const noexcept;
+    int limitOversampling (const int order) const noexcept;
+    int limitUnison (const int numVoices) const noexcept;
+
+    // Envelope level under which a released note is ended; 0 keeps every release
+    float getReleaseFloor() const noexcept;
+
+private:
+    // Proportions of the time a block has to render in
+    static constexpr double stepDownLoad { 0.85 };
+    static constexpr double stepUpLoad { 0.5 };
+    static constexpr double stepDownSeconds { 0.25 };
+    static constexpr double stepUpSeconds { 2.0 };
+
+    juce::AudioProcessLoadMeasurer loadMeasurer;
+    std::atomic<int> quality { full };
+
+    int stepDownSamples { 11025 };
+    int stepUpSamples { 88200 };
+    int samplesOver { 0 };
+    int samplesUnder { 0 };
+    int lastXRunCount { 0 };
+};
@@ -1,7 +1,7 @@
 /*
   ==============================================================================
 
-    HarmonicOsc.h
+    HarmonicData.h
     Created: 10 Feb 2022 11:52:01pm
     Author:  morchella
 
@@ -10,27 +10,80 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include "OscData.h"
 
-class HarmonicData : public OscData::OscData
+// One entry of the partial table. The ratio is the partial's frequency
+// relative to the played note.
+struct PartialInfo
+{
+    float ratio { 1.0f };
+    juce::String paramId;
+    juce::String paramName;
+    juce::String label;
+    float defaultGain { -100.0f };
+};
+
+// The table every part of the synth is generated from: the parameter layout,
+// the oscillator bank in each voice and the drawbars in the editor. Partials
+// are ordered by ratio, lowest subharmonic first, with the fundamental
+// (OSC1GAIN) in the middle.
+class HarmonicData
 {
 public:
-    void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
-    void setType (const int oscSelection);
-    void setGain (const float levelInDecibels);
-    void setOscPitch (const int pitch);
-    void setFreq (const int midiNoteNumber);
-    void setFmOsc (const float freq, const float depth);
-    void renderNextBlock (juce::dsp::AudioBlock<float>& audioBlock);
-    float processNextSample (float input);
-    void setParams (const int oscChoice, const float oscGain, const int oscPitch, const float fmFreq, const float fmDepth);
-    void resetAll();
+    static constexpr int maxSubharmonics { 64 };
+    static constexpr int maxOvertones { 64 };
+    static constexpr int numPartials { maxSubharmonics + 1 + maxOvertones };
+    static constexpr int fundamentalIndex { maxSubharmonics };
+
+    // Partials beyond this many per side start switched off
+    static constexpr int numDefaultPartials { 9 };
+    static constexpr float defaultGain { -20.0f };
+    static constexpr float minGain { -100.0f };
+    static constexpr float maxGain { 0.2f };
+
+    static const std::array<PartialInfo, numPartials>& getPartials()
+    {
+        static const auto partials = createPartials();
+        return partials;
+    }
+
+    static bool isFundamental (const int index) { return index == fundamentalIndex; }
+    static bool isSubharmonic (const int index) { return index < fundamentalIndex; }
+
+    // 1 for the first subharmonic or overtone, 0 for the fundamental
+    static int getPartialNumber (const int index) { return std::abs (index - fundamentalIndex); }
 
 private:
-    juce::dsp::Oscillator<float> fmOsc { [](float x) { return std::sin (x); }};
-    juce::dsp::Gain<float> gain;
-    int lastPitch { 0 };
-    int lastMidiNote { 0 };
-    float fmDepth { 0.0f };
-    float fmModulator { 0.0f };
+    static std::array<PartialInfo, numPartials> createPartials()
+    {
+        std::array<PartialInfo, numPartials> partials;
+
+        for (int n = 1; n <= maxSubharmonics; ++n)
+        {
+            auto& partial = partials[(size_t) (fundamentalIndex - n)];
+            partial.ratio = 1.0f / (float) (n + 1);
+            partial.paramId = "SUB" + juce::String (n) + "GAIN";
+            partial.paramName = "Subharmonic " + juce::String (n) + " Gain";
+            partial.label = "-" + juce::String (n);
+            partial.defaultGain = n <= numDefaultPartials ? defaultGain : minGain;
+        }
+
+        auto& fundamental = partials[(size_t) fundamentalIndex];
+        fundamental.ratio = 1.0f;
+        fundamental.paramId = "OSC1GAIN";
+        fundamental.paramName = "Oscillator 1 Gain";
+        fundamental.label = "0";
+        fundamental.defaultGain = defaultGain;
+
+        for (int n = 1; n <= maxOvertones; ++n)
+        {
+            auto& partial = partials[(size_t) (fundamentalIndex + n)];
+            partial.ratio = (float) (n + 1);
+            partial.paramId = "OV" + juce::String (n) + "GAIN";
+            partial.paramName = "Overtone " + juce::String (n) + " Gain";
+            partial.label = juce::String (n);
+            partial.defaultGain = n <= numDefaultPartials ? defaultGain : minGain;
+        }
+
+        return partials;
+    }
 };
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    IfftOscData.cpp
+    Created: 19 Oct 2026 5:02:37pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "IfftOscData.h"
+
+template <typename SampleType>
+IfftOscData<SampleType>::Tables::Tables()
+{
+    // Periodic 4 term Blackman-Harris, main lobe 4 bins either side, side lobes at -92 dB
+    std::vector<double> window ((size_t) fftSize);
+
+    for (int n = 0; n < fftSize; ++n)
+    {
+        const auto x = juce::MathConstants<double>::twoPi * n / fftSize;
+        window[(size_t) n] = 0.35875 - 0.48829 * std::cos (x) + 0.14128 * std::cos (2.0 * x) - 0.01168 * std::cos (3.0 * x);
+    }
+
+    // Transform of the window centred on the middle of the frame, so it is real and even
+    for (int j = 0; j < kernelSize; ++j)
+    {
+        const auto offset = (double) j / kernelOversampling;
+        auto sum = 0.0;
+
+        for (int m = -fftSize / 2; m < fftSize / 2; ++m)
+            sum += window[(size_t) (m + fftSize / 2)] * std::cos (juce::MathConstants<double>::twoPi * offset * m / fftSize);
+
+        kernel[(size_t) j] = (float) sum;
+    }
+
+    for (int m = 0; m < fftSize / 2; ++m)
+    {
+        const auto triangle = 1.0 - std::abs (m - fftSize / 4) / (double) (fftSize / 4);
+        synthesisWindow[(size_t) m] = (float) (triangle / window[(size_t) (m + fftSize / 4)]);
+    }
+}
+
+template <typename SampleType>
+const typename IfftOscData<SampleType>::Tables& IfftOscData<SampleType>::getTables()
+{
+    static const Tables tables;
+    return tables;
+}
+
+template <typename SampleType>
+float IfftOscData<SampleType>::getKernel (const Tables& tables, const float binOffset) noexcept
+{
+    const auto position = std::abs (binOffset) * (float) kernelOversampling;
+    const auto index = (int) position;
+
+    if (index >= kernelSize - 1)
+        return 0.0f;
+
+    const auto fraction = position - (float) index;
+    return tables.kernel[(size_t) index] + fraction * (tables.kernel[(size_t) index + 1] - tables.kernel[(size_t) index]);
+}
+
+template <typename SampleType>
+void IfftOscData<SampleType>::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+{
+    // Builds the tables here rather than on the audio thread
+    getTables();
+
+    spectrum.assign ((size_t) (2 * fftSize), 0.0f);
+    overlap.assign ((size_t) (fftSize / 2), 0.0f);
+    reset();
+}
+
+template <typename SampleType>
+void IfftOscData<SampleType>::reset()
+{
+    std::fill (overlap.begin(), overlap.end(), 0.0f);
+    overlapRead = hopSize;
+}
+
+template <typename SampleType>
+void IfftOscData<SampleType>::renderNextBlock (SampleType* output, const int numSamples, const SampleType* increment, const SampleType* gain, SampleType* phase, const int numPartials)
+{
+    jassert (! overlap.empty());
+
+    for (int done = 0; done < numSamples;)
+    {
+        if (overlapRead == hopSize)
+        {
+            // The first hop is finished; shift the rest down and add the next frame on top
+            std::copy (overlap.begin() + hopSize, overlap.end(), overlap.begin());
+            std::fill (overlap.end() - hopSize, overlap.end(), 0.0f);
+            synthesiseFrame (increment, gain, phase, numPartials);
+            overlapRead = 0;
+        }
+
+        const auto n = juce::jmin (hopSize - overlapRead, numSamples - done);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            juce::FloatVectorOperations::add (output + done, overlap.data() + overlapRead, n);
+        }
+        else
+        {
+            for (int s = 0; s < n; ++s)
+                output[done + s] += (SampleType) overlap[(size_t) (overlapRead + s)];
+        }
+
+        overlapRead += n;
+        done += n;
+    }
+}
+
+template <typename SampleType>
+void IfftOscData<SampleType>::synthesiseFrame (const SampleType* increment, const SampleType* gain, SampleType* phase, const int numPartials)
+{
+    const auto& tables = getTables();
+    const auto maxBin = (float) (fftSize / 2 - lobeHalfWidth - 1);
+
+    std::fill (spectrum.begin(), spectrum.end(), 0.0f);
+
+    for (int i = 0; i < numPartials; ++i)
+    {
+        // The frame is centred one hop after the first sample it completes
+        const auto nextPhase = phase[i] + increment[i] * (SampleType) hopSize;
+        phase[i] = nextPhase - (SampleType) (int) nextPhase;
+
+        const auto centreBin = (float) (increment[i] * (SampleType) fftSize);
+
+        // Lobes reaching past Nyquist would need mirroring; those partials are left out
+        if (centreBin < maxBin && gain[i] > 0)
+        {
+            // Same starting phase as the oscillator bank's sine, -sin (2 pi phase)
+            const auto angle = juce::MathConstants<SampleType>::twoPi * phase[i];
+            const auto cosPhase = (float) -std::sin (angle);
+            const auto sinPhase = (float) std::cos (angle);
+            const auto amplitude = 0.5f * (float) gain[i];
+
+            const auto first = juce::jmax (0, (int) std::ceil (centreBin - (float) lobeHalfWidth));
+            const auto last = (int) std::floor (centreBin + (float) lobeHalfWidth);
+
+            for (int k = first; k <= last; ++k)
+            {
+                // (-1)^k moves the frame centre to sample fftSize / 2
+                const auto weight = (k & 1 ? -amplitude : amplitude) * getKernel (tables, (float) k - centreBin);
+                spectrum[(size_t) (2 * k)] += weight * cosPhase;
+                spectrum[(size_t) (2 * k + 1)] += weight * sinPhase;
+            }
+
+            // Negative frequency image, only reaches the positive bins for the lowest partials
+            for (int k = 0; (float) k <= (float) lobeHalfWidth - centreBin; ++k)
+            {
+                const auto weight = (k & 1 ? -amplitude : amplitude) * getKernel (tables, (float) k + centreBin);
+                spectrum[(size_t) (2 * k)] += weight * cosPhase;
+                spectrum[(size_t) (2 * k + 1)] -= weight * sinPhase;
+            }
+        }
+    }
+
+    fft.performRealOnlyInverseTransform (spectrum.data());
+
+    const auto* frame = spectrum.data() + fftSize / 4;
+    const auto* window = tables.synthesisWindow.data();
+
+    for (int m = 0; m < fftSize / 2; ++m)
+        overlap[(size_t) m] += frame[m] * window[m];
+}
+
+template class IfftOscData<float>;
+template class IfftOscData<double>;
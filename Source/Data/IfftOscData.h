@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    IfftOscData.h
+    Created: 19 Oct 2026 5:02:37pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Inverse FFT additive synthesis (FFT-1, Rodet and Depalle). Every hop, each
+// partial is written into a spectrum as the 9 bin main lobe of a
+// Blackman-Harris window centred on its frequency. One inverse FFT then
+// gives the BH-windowed sum of all partials. Dividing the middle half of the
+// frame by the BH window and multiplying by a triangle gives frames that
+// overlap-add to a constant at a hop of a quarter frame. The cost per hop is
+// one FFT plus 9 bins per partial, instead of one oscillator per partial per
+// sample.
+//
+// The transform is always single precision; phases, increments and gains are
+// held at the sample type of the bank that owns it.
+template <typename SampleType>
+class IfftOscData
+{
+public:
+    static constexpr int fftOrder { 10 };
+    static constexpr int fftSize { 1 << fftOrder };
+    static constexpr int hopSize { fftSize / 4 };
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
+    void reset();
+
+    // Adds numSamples of output. Phases are in cycles and are advanced by one
+    // hop for every frame that is synthesised, so they line up with the
+    // oscillator bank at the start of each hop.
+    void renderNextBlock (SampleType* output, const int numSamples, const SampleType* increment, const SampleType* gain, SampleType* phase, const int numPartials);
+
+private:
+    static constexpr int lobeHalfWidth { 4 };
+    static constexpr int kernelOversampling { 64 };
+    static constexpr int kernelSize { lobeHalfWidth * kernelOversampling + 2 };
+
+    struct Tables
+    {
+        Tables();
+
+        // Blackman-Harris spectrum at fractional bin offsets 0..4, frame centred (real, even)
+        std::array<float, kernelSize> kernel {};
+
+        // Triangle over the middle half of the frame divided by the BH window
+        std::array<float, fftSize / 2> synthesisWindow {};
+    };
+
+    static const Tables& getTables();
+    static float getKernel (const Tables& tables, const float binOffset) noexcept;
+
+    void synthesiseFrame (const SampleType* increment, const SampleType* gain, SampleType* phase, const int numPartials);
+
+    juce::dsp::FFT fft { fftOrder };
+    std::vector<float> spectrum;
+
+    // Output for the next fftSize / 2 samples; the first hopSize are complete
+    std::vector<float> overlap;
+    int overlapRead { hopSize };
+};
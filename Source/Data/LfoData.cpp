@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    LfoData.cpp
+    Created: 19 Oct 2026 11:20:46pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "LfoData.h"
+
+namespace
+{
+    // Linear congruential step, and its top 24 bits as -1 to 1
+    inline juce::uint32 nextRandom (const juce::uint32 state) noexcept { return state * 1664525u + 1013904223u; }
+    inline float toBipolar (const juce::uint32 state) noexcept { return (float) (state >> 8) * (2.0f / 16777216.0f) - 1.0f; }
+}
+
+juce::StringArray LfoData::getShapeNames()
+{
+    return { "Sine", "Triangle", "Saw", "Square", "Sample & Hold" };
+}
+
+juce::StringArray LfoData::getDivisionNames()
+{
+    return { "1/16", "1/8T", "1/8", "1/4T", "1/4", "1/2", "1 Bar", "2 Bars", "4 Bars" };
+}
+
+double LfoData::getBeatsPerCycle (const int division) noexcept
+{
+    switch (division)
+    {
+        case 0:     return 0.25;
+        case 1:     return 1.0 / 3.0;
+        case 2:     return 0.5;
+        case 3:     return 2.0 / 3.0;
+        case 4:     return 1.0;
+        case 5:     return 2.0;
+        case 6:     return 4.0;
+        case 7:     return 8.0;
+        case 8:     return 16.0;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            return 1.0;
+    }
+}
+
+LfoData::LfoData()
+{
+    // Every column gets its own sequence
+    for (int lfo = 0; lfo < numLfos; ++lfo)
+    {
+        for (int column = 0; column < numColumns; ++column)
+        {
+            auto& state = randomState[(size_t) lfo][(size_t) column];
+            state = nextRandom ((juce::uint32) (lfo * numColumns + column + 1) * 2654435761u);
+            held[(size_t) lfo][(size_t) column] = toBipolar (state);
+        }
+    }
+}
+
+void LfoData::prepareToPlay (double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    for (auto& row : phase)
+        row.fill (0.0f);
+}
+
+void LfoData::setParams (const int lfo, const int shape, const float rateHz, const bool sync, const int division, const int mode)
+{
+    auto& s = settings[(size_t) lfo];
+    s.shape = shape;
+    s.rate = rateHz;
+    s.sync = sync;
+    s.division = division;
+    s.mode = mode;
+}
+
+void LfoData::noteOn (const int voice) noexcept
+{
+    for (int lfo = 0; lfo < numLfos; ++lfo)
+    {
+        if (settings[(size_t) lfo].mode != perVoice)
+            continue;
+
+        const auto v = (size_t) voice;
+        phase[(size_t) lfo][v] = 0.0f;
+
+        auto& state = randomState[(size_t) lfo][v];
+        state = nextRandom (state);
+        held[(size_t) lfo][v] = toBipolar (state);
+    }
+}
+
+void LfoData::advance (const int numSamples, const juce::AudioPlayHead::CurrentPositionInfo& position) noexcept
+{
+    for (int lfo = 0; lfo < numLfos; ++lfo)
+    {
+        const auto& s = settings[(size_t) lfo];
+        const auto isSynced = s.sync && position.bpm > 0.0;
+        const auto beatsPerCycle = getBeatsPerCycle (s.division);
+        const auto cyclesPerSecond = isSynced ? position.bpm / 60.0 / beatsPerCycle : (double) s.rate;
+        const auto increment = (float) (cyclesPerSecond * numSamples / currentSampleRate);
+
+        // A global synced LFO takes its phase from the host's position while it plays
+        const auto followsHost = isSynced && position.isPlaying && s.mode == global;
+
+        if (followsHost)
+        {
+            const auto cycles = position.ppqPosition / beatsPerCycle;
+            const auto cycle = (juce::int64) std::floor (cycles);
+            phase[(size_t) lfo][(size_t) globalColumn] = (float) (cycles - (double) cycle);
+
+            if (cycle != hostCycle[(size_t) lfo])
+            {
+                hostCycle[(size_t) lfo] = cycle;
+                auto& state = randomState[(size_t) lfo][(size_t) globalColumn];
+                state = nextRandom (state);
+                held[(size_t) lfo][(size_t) globalColumn] = toBipolar (state);
+            }
+        }
+
+        if (s.mode == global)
+        {
+            evaluate (lfo, globalColumn, 1);
+            std::fill (value[(size_t) lfo].begin(), value[(size_t) lfo].begin() + globalColumn, value[(size_t) lfo][(size_t) globalColumn]);
+
+            if (! followsHost)
+                step (lfo, globalColumn, 1, increment);
+        }
+        else
+        {
+            evaluate (lfo, 0, numColumns);
+            step (lfo, 0, numColumns, increment);
+        }
+    }
+}
+
+void LfoData::evaluate (const int lfo, const int firstColumn, const int numToEvaluate) noexcept
+{
+    const auto* p = phase[(size_t) lfo].data() + firstColumn;
+    auto* v = value[(size_t) lfo].data() + firstColumn;
+
+    // One shape per loop, so each loop is branch free across the columns
+    switch (settings[(size_t) lfo].shape)
+    {
+        case sine:
+            for (int c = 0; c < numToEvaluate; ++c)
+                v[c] = std::sin (juce::MathConstants<float>::twoPi * p[c]);
+            break;
+
+        case triangle:
+            // Starts at 0 and rises, like the sine
+            for (int c = 0; c < numToEvaluate; ++c)
+            {
+                const auto shifted = p[c] + 0.75f;
+                v[c] = 4.0f * std::abs (shifted - (float) (int) shifted - 0.5f) - 1.0f;
+            }
+            break;
+
+        case saw:
+            for (int c = 0; c < numToEvaluate; ++c)
+                v[c] = 2.0f * p[c] - 1.0f;
+            break;
+
+        case square:
+            for (int c = 0; c < numToEvaluate; ++c)
+                v[c] = p[c] < 0.5f ? 1.0f : -1.0f;
+            break;
+
+        case sampleAndHold:
+            std::copy (held[(size_t) lfo].begin() + firstColumn, held[(size_t) lfo].begin() + firstColumn + numToEvaluate, v);
+            break;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            break;
+    }
+}
+
+void LfoData::step (const int lfo, const int firstColumn, const int numToStep, const float increment) noexcept
+{
+    auto* p = phase[(size_t) lfo].data() + firstColumn;
+    auto* h = held[(size_t) lfo].data() + firstColumn;
+    auto* r = randomState[(size_t) lfo].data() + firstColumn;
+
+    for (int c = 0; c < numToStep; ++c)
+    {
+        const auto next = p[c] + increment;
+        const auto wrapped = next >= 1.0f;
+        p[c] = next - std::floor (next);
+
+        // Every column draws, and only the ones that wrapped keep the new value
+        const auto drawn = nextRandom (r[c]);
+        r[c] = wrapped ? drawn : r[c];
+        h[c] = wrapped ? toBipolar (drawn) : h[c];
+    }
+}
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    LfoData.h
+    Created: 19 Oct 2026 11:20:46pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ExpressionData.h"
+
+// The synth's LFOs, evaluated once per control block rather than per
+// sample. Each LFO has a phase and value per voice, kept as flat arrays with
+// the same columns as the modulation matrix: one per voice and a last, shared
+// one. A global LFO only advances the shared column and copies its value to
+// every voice; a per-voice LFO restarts with each note and advances all
+// columns together.
+//
+// Synced LFOs take their rate from the host tempo, and a global one also
+// takes its phase from the host position while the transport runs.
+class LfoData
+{
+public:
+    enum Shape
+    {
+        sine = 0,
+        triangle,
+        saw,
+        square,
+        sampleAndHold
+    };
+
+    enum Mode
+    {
+        global = 0,
+        perVoice
+    };
+
+    static constexpr int numLfos { 2 };
+    static constexpr int globalColumn { ExpressionData::maxVoices };
+    static constexpr int numColumns { ExpressionData::maxVoices + 1 };
+
+    static juce::StringArray getShapeNames();
+    static juce::StringArray getDivisionNames();
+
+    LfoData();
+
+    void prepareToPlay (double sampleRate);
+
+    // Division indexes getDivisionNames() and only applies when synced
+    void setParams (const int lfo, const int shape, const float rateHz, const bool sync, const int division, const int mode);
+
+    // Audio thread, from the voice
+    void noteOn (const int voice) noexcept;
+
+    // Audio thread, once per control block. The values are those at the start of the block.
+    void advance (const int numSamples, const juce::AudioPlayHead::CurrentPositionInfo& position) noexcept;
+
+    // -1 to 1
+    float getValue (const int lfo, const int column) const noexcept { return value[(size_t) lfo][(size_t) column]; }
+
+private:
+    struct Settings
+    {
+        int shape { sine };
+        float rate { 0.0f };
+        bool sync { false };
+        int division { 0 };
+        int mode { global };
+    };
+
+    static double getBeatsPerCycle (const int division) noexcept;
+    void evaluate (const int lfo, const int firstColumn, const int numToEvaluate) noexcept;
+    void step (const int lfo, const int firstColumn, const int numToStep, const float increment) noexcept;
+
+    double currentSampleRate { 44100.0 };
+    std::array<Settings, numLfos> settings;
+
+    // In cycles, [0, 1)
+    alignas (16) std::array<std::array<float, numColumns>, numLfos> phase {};
+    alignas (16) std::array<std::array<float, numColumns>, numLfos> value {};
+
+    // Sample and hold draws a new value from its own generator every cycle
+    alignas (16) std::array<std::array<float, numColumns>, numLfos> held {};
+    alignas (16) std::array<std::array<juce::uint32, numColumns>, numLfos> randomState {};
+
+    // Host cycle of the last block, for a global LFO that follows the host
+    std::array<juce::int64, numLfos> hostCycle {};
+};
@@ -10,46 +10,203 @@
 
 #include "MeterData.h"
 
-void MeterData::processRMS (juce::AudioBuffer<float>& buffer)
+void MeterData::Biquad::setCoefficients (double nb0, double nb1, double nb2, double a0, double na1, double na2)
 {
-    // Running total of all samples in the callback
-    float sum = 0;
+    b0 = nb0 / a0;
+    b1 = nb1 / a0;
+    b2 = nb2 / a0;
+    a1 = na1 / a0;
+    a2 = na2 / a0;
+}
+
+float MeterData::Biquad::process (float x) noexcept
+{
+    const auto y = b0 * x + z1;
+    z1 = b1 * x - a1 * y + z2;
+    z2 = b2 * x - a2 * y;
+    return (float) y;
+}
+
+void MeterData::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+{
+    numChannels = juce::jlimit (1, maxChannels, outputChannels);
+    binLength = juce::jmax (1, juce::roundToInt (sampleRate * 0.1));
+    binFill = 0;
+    binIndex = 0;
+    binsFilled = 0;
+    loudnessBins.fill (0.0);
+
+    // K-weighting pre-filter and RLB high-pass from BS.1770, re-derived for any sample rate
+    const auto pi = juce::MathConstants<double>::pi;
+
+    auto k = std::tan (pi * 1681.974450955533 / sampleRate);
+    const auto shelfQ = 0.7071752369554196;
+    const auto vh = std::pow (10.0, 3.999843853973347 / 20.0);
+    const auto vb = std::pow (vh, 0.4996667741545416);
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    for (auto& state : channelState)
+        state.shelf.setCoefficients (vh + vb * k / shelfQ + k * k, 2.0 * (k * k - vh), vh - vb * k / shelfQ + k * k,
+                                     1.0 + k / shelfQ + k * k, 2.0 * (k * k - 1.0), 1.0 - k / shelfQ + k * k);
+
+    k = std::tan (pi * 38.13547087602444 / sampleRate);
+    const auto highpassQ = 0.5003270373238773;
+    const auto a0 = 1.0 + k / highpassQ + k * k;
+
+    // BS.1770 keeps this numerator at 1, -2, 1, so it is scaled by a0 to come through the normalisation unchanged
+    for (auto& state : channelState)
+        state.highpass.setCoefficients (a0, -2.0 * a0, a0,
+                                        a0, 2.0 * (k * k - 1.0), 1.0 - k / highpassQ + k * k);
+
+    // Hann windowed sinc, 12 taps per phase. Phase 0 lands on the input samples, so only phases 1-3 are computed.
+    for (int p = 0; p < oversampling; ++p)
     {
-        auto output = buffer.getReadPointer (ch);
+        auto sum = 0.0f;
 
-        for (int s = 0; s < buffer.getNumSamples(); ++s)
+        for (int j = 0; j < tapsPerPhase; ++j)
         {
-            auto squaredSample = output[s] * output[s];
-            sum+=squaredSample;
+            const auto t = (float) (tapsPerPhase / 2 - 1 - j) + (float) p / (float) oversampling;
+            const auto sinc = t == 0.0f ? 1.0f : std::sin (juce::MathConstants<float>::pi * t) / (juce::MathConstants<float>::pi * t);
+            const auto window = 0.5f + 0.5f * std::cos (juce::MathConstants<float>::pi * t / ((float) tapsPerPhase / 2.0f + 0.5f));
+
+            truePeakTaps[(size_t) p][(size_t) j] = sinc * window;
+            sum += sinc * window;
         }
 
-        auto avg = sum / buffer.getNumSamples();
-        rms.store (std::sqrt (avg));
+        for (auto& tap : truePeakTaps[(size_t) p])
+            tap /= sum;
+    }
+
+    for (auto& state : channelState)
+    {
+        state.history.fill (0.0f);
+        state.historyIndex = 0;
+        state.shelf.reset();
+        state.highpass.reset();
+        state.binEnergy = 0.0;
     }
+
+    current = Snapshot();
+    current.numChannels = numChannels;
 }
 
-void MeterData::processPeak (juce::AudioBuffer<float>& buffer)
+void MeterData::processNextBlock (const juce::AudioBuffer<float>& buffer)
 {
-    auto max = 0.0f;
+    const auto channels = juce::jmin (numChannels, buffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+
+    std::array<float, maxChannels> sumSquares {}, peak {}, truePeak {};
+
+    // Split the block at loudness bin boundaries, every sample is still visited once
+    for (int s = 0; s < numSamples;)
+    {
+        const auto n = juce::jmin (numSamples - s, binLength - binFill);
+
+        for (int ch = 0; ch < channels; ++ch)
+            processSpan (channelState[(size_t) ch], buffer.getReadPointer (ch, s), n, sumSquares[(size_t) ch], peak[(size_t) ch], truePeak[(size_t) ch]);
+
+        s += n;
+        binFill += n;
+
+        if (binFill == binLength)
+            completeLoudnessBin();
+    }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    for (int ch = 0; ch < maxChannels; ++ch)
     {
-        auto output = buffer.getReadPointer (ch);
-        
-        for (int s = 0; s < buffer.getNumSamples(); ++s)
+        // A mono output shows the same reading on both meters
+        const auto source = (size_t) juce::jmin (ch, channels - 1);
+
+        current.rms[(size_t) ch] = numSamples > 0 ? std::sqrt (sumSquares[source] / (float) numSamples) : 0.0f;
+        current.peak[(size_t) ch] = peak[source];
+        current.truePeak[(size_t) ch] = juce::jmax (truePeak[source], peak[source]);
+        current.maxTruePeak[(size_t) ch] = juce::jmax (current.maxTruePeak[(size_t) ch], current.truePeak[(size_t) ch]);
+    }
+
+    snapshots[(size_t) writeIndex] = current;
+    writeIndex = middleIndex.exchange (writeIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+}
+
+void MeterData::processSpan (ChannelState& state, const float* input, int numSamples, float& sumSquares, float& peak, float& truePeak) noexcept
+{
+    auto energy = 0.0;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        const auto x = input[s];
+
+        sumSquares += x * x;
+        peak = juce::jmax (peak, std::abs (x));
+
+        state.history[(size_t) state.historyIndex] = x;
+        state.history[(size_t) (state.historyIndex + tapsPerPhase)] = x;
+
+        if (++state.historyIndex == tapsPerPhase)
+            state.historyIndex = 0;
+
+        const auto* window = state.history.data() + state.historyIndex;
+
+        for (int p = 1; p < oversampling; ++p)
         {
-            auto abs = std::abs (output[s]);
-            
-            if (abs > max)
-                max = abs;
+            const auto* taps = truePeakTaps[(size_t) p].data();
+            auto y = 0.0f;
+
+            for (int j = 0; j < tapsPerPhase; ++j)
+                y += window[j] * taps[j];
+
+            truePeak = juce::jmax (truePeak, std::abs (y));
         }
-        
-        peak.store (max);
+
+        const auto weighted = state.highpass.process (state.shelf.process (x));
+        energy += weighted * weighted;
+    }
+
+    state.binEnergy += energy;
+}
+
+void MeterData::completeLoudnessBin()
+{
+    auto energy = 0.0;
+
+    // Channel weights are 1.0 for left and right
+    for (auto& state : channelState)
+    {
+        energy += state.binEnergy;
+        state.binEnergy = 0.0;
     }
+
+    loudnessBins[(size_t) binIndex] = energy;
+    binIndex = (binIndex + 1) % shortTermBins;
+    binsFilled = juce::jmin (binsFilled + 1, shortTermBins);
+    binFill = 0;
+
+    current.momentaryLoudness = getLoudness (momentaryBins);
+    current.shortTermLoudness = getLoudness (shortTermBins);
 }
 
+float MeterData::getLoudness (int numBins) const
+{
+    numBins = juce::jmin (numBins, binsFilled);
+
+    if (numBins == 0)
+        return silenceLoudness;
 
+    auto energy = 0.0;
 
+    for (int i = 1; i <= numBins; ++i)
+        energy += loudnessBins[(size_t) ((binIndex - i + shortTermBins) % shortTermBins)];
 
+    const auto meanSquare = energy / ((double) numBins * binLength);
+
+    if (meanSquare <= 0.0)
+        return silenceLoudness;
+
+    return juce::jmax (silenceLoudness, (float) (-0.691 + 10.0 * std::log10 (meanSquare)));
+}
+
+const MeterData::Snapshot& MeterData::readSnapshot()
+{
+    if (middleIndex.load (std::memory_order_relaxed) & freshBit)
+        readIndex = middleIndex.exchange (readIndex, std::memory_order_acq_rel) & indexMask;
+
+    return snapshots[(size_t) readIndex];
+}
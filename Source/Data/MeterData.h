@@ -11,16 +11,80 @@
 #pragma once
 #include <JuceHeader.h>
 
+// Per-channel RMS, sample peak and 4x oversampled true peak (ITU-R BS.1770-4
+// Annex 2), plus EBU R128 momentary (400 ms) and short-term (3 s) loudness.
+// Everything is measured in a single pass over the block, and the results are
+// handed to the UI through a lock-free triple buffer.
 class MeterData
 {
 public:
-    void processRMS (juce::AudioBuffer<float>& buffer);
-    void processPeak (juce::AudioBuffer<float>& buffer);
-    
-    const std::atomic<float>& getRMS() { return rms; }
-    const std::atomic<float>& getPeak() { return peak; }
-    
+    static constexpr int maxChannels { 2 };
+    static constexpr float silenceLoudness { -100.0f };
+
+    struct Snapshot
+    {
+        int numChannels { 0 };
+        std::array<float, maxChannels> rms {};
+        std::array<float, maxChannels> peak {};
+        std::array<float, maxChannels> truePeak {};
+        std::array<float, maxChannels> maxTruePeak {};
+        float momentaryLoudness { silenceLoudness };
+        float shortTermLoudness { silenceLoudness };
+    };
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
+    void processNextBlock (const juce::AudioBuffer<float>& buffer);
+
+    // Message thread only; returns the most recent complete measurement
+    const Snapshot& readSnapshot();
+
 private:
-    std::atomic<float> rms { 0.0f };
-    std::atomic<float> peak { 0.0f };
+    static constexpr int oversampling { 4 };
+    static constexpr int tapsPerPhase { 12 };
+    static constexpr int momentaryBins { 4 };
+    static constexpr int shortTermBins { 30 };
+    static constexpr int freshBit { 4 };
+    static constexpr int indexMask { 3 };
+
+    struct Biquad
+    {
+        void setCoefficients (double b0, double b1, double b2, double a0, double a1, double a2);
+        float process (float x) noexcept;
+        void reset() noexcept { z1 = z2 = 0.0; }
+
+        double b0 { 1.0 }, b1 { 0.0 }, b2 { 0.0 }, a1 { 0.0 }, a2 { 0.0 };
+        double z1 { 0.0 }, z2 { 0.0 };
+    };
+
+    struct ChannelState
+    {
+        // Doubled history so the last tapsPerPhase samples are always contiguous
+        std::array<float, 2 * tapsPerPhase> history {};
+        int historyIndex { 0 };
+        Biquad shelf;
+        Biquad highpass;
+        double binEnergy { 0.0 };
+    };
+
+    void processSpan (ChannelState& state, const float* input, int numSamples, float& sumSquares, float& peak, float& truePeak) noexcept;
+    void completeLoudnessBin();
+    float getLoudness (int numBins) const;
+
+    int numChannels { 0 };
+    std::array<ChannelState, maxChannels> channelState;
+    std::array<std::array<float, tapsPerPhase>, oversampling> truePeakTaps {};
+
+    int binLength { 4800 };
+    int binFill { 0 };
+    int binIndex { 0 };
+
+    // Until the window has filled, loudness averages only the bins measured so far
+    int binsFilled { 0 };
+    std::array<double, shortTermBins> loudnessBins {};
+
+    Snapshot current;
+    std::array<Snapshot, 3> snapshots;
+    int writeIndex { 0 };
+    int readIndex { 1 };
+    std::atomic<int> middleIndex { 2 };
 };
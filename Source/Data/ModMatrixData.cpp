@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    ModMatrixData.cpp
+    Created: 19 Oct 2026 10:41:09pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "ModMatrixData.h"
+
+juce::StringArray ModMatrixData::getSourceNames()
+{
+    return { "None", "LFO 1", "LFO 2", "Amp Envelope", "Filter Envelope", "Velocity", "Key", "Pressure", "Slide" };
+}
+
+juce::StringArray ModMatrixData::getDestinationNames()
+{
+    return { "None", "Morph", "Tilt", "Subharmonic Level", "Overtone Level", "Cutoff", "Resonance", "Pitch", "Reverb Wet" };
+}
+
+float ModMatrixData::getDestinationRange (const int destination) noexcept
+{
+    switch (destination)
+    {
+        case noDestination:     return 0.0f;
+        case morph:             return 1.0f;
+        case tilt:              return 12.0f;
+        case subharmonicLevel:  return 24.0f;
+        case overtoneLevel:     return 24.0f;
+        case cutoff:            return 4.0f;
+        case resonance:         return 1.0f;
+        case pitch:             return 12.0f;
+        case reverbWet:         return 1.0f;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            return 0.0f;
+    }
+}
+
+void ModMatrixData::setRoute (const int index, const int source, const int destination, const float depth) noexcept
+{
+    jassert (juce::isPositiveAndBelow (index, maxRoutes));
+
+    auto& route = routes[(size_t) index];
+    route.source = juce::jlimit (0, numSources - 1, source);
+    route.destination = juce::jlimit (0, numDestinations - 1, destination);
+
+    // Scaled to the destination's units here, so process() only multiplies
+    route.depth = depth * getDestinationRange (route.destination);
+}
+
+void ModMatrixData::process() noexcept
+{
+    for (auto& row : destinations)
+        juce::FloatVectorOperations::clear (row.data(), numColumns);
+
+    for (const auto& route : routes)
+    {
+        if (route.source == noSource || route.destination == noDestination || route.depth == 0.0f)
+            continue;
+
+        juce::FloatVectorOperations::addWithMultiply (destinations[(size_t) route.destination].data(), sources[(size_t) route.source].data(), route.depth, numColumns);
+    }
+}
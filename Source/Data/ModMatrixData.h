@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    ModMatrixData.h
+    Created: 19 Oct 2026 10:41:09pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ExpressionData.h"
+
+// Modulation routing as a flat table of (source, destination, depth) routes.
+// Source values and destination amounts are kept as one row per source or
+// destination with a column per voice, plus one column for modulation that
+// is not tied to a voice. The LFOs fill that column from their own global
+// phase; the per-voice sources take the values of the most recently started
+// note still playing, and hold them once every note has ended, so global
+// destinations such as reverb wet follow the latest note. Once per control
+// block each route adds its source row, scaled by its depth, to its
+// destination row across every column at once, so a route costs one vector
+// multiply-add whatever the voice count.
+class ModMatrixData
+{
+public:
+    // Unipolar 0 to 1, except the LFOs and slide (-1 to 1) and key (octaves from middle C)
+    enum Source
+    {
+        noSource = 0,
+        lfo1,
+        lfo2,
+        ampEnvelope,
+        filterEnvelope,
+        velocity,
+        key,
+        pressure,
+        slide,
+        numSources
+    };
+
+    // A depth of 1 moves a destination by its range; see getDestinationRange()
+    enum Destination
+    {
+        noDestination = 0,
+        morph,
+        tilt,
+        subharmonicLevel,
+        overtoneLevel,
+        cutoff,
+        resonance,
+        pitch,
+        reverbWet,
+        numDestinations
+    };
+
+    static constexpr int maxRoutes { 8 };
+    static constexpr int globalColumn { ExpressionData::maxVoices };
+    static constexpr int numColumns { ExpressionData::maxVoices + 1 };
+
+    static juce::StringArray getSourceNames();
+    static juce::StringArray getDestinationNames();
+
+    // Morph position, dB/oct, dB, dB, octaves, resonance, semitones and wet level
+    static float getDestinationRange (const int destination) noexcept;
+
+    // Depth is -1 to 1
+    void setRoute (const int index, const int source, const int destination, const float depth) noexcept;
+
+    // Sources not set for a column keep their last value; all start at 0
+    void setSource (const Source source, const int column, const float value) noexcept { sources[(size_t) source][(size_t) column] = value; }
+
+    // Once per control block, after the sources are set
+    void process() noexcept;
+
+    float getDestination (const Destination destination, const int column) const noexcept { return destinations[(size_t) destination][(size_t) column]; }
+
+private:
+    struct Route
+    {
+        int source { noSource };
+        int destination { noDestination };
+        float depth { 0.0f };
+    };
+
+    std::array<Route, maxRoutes> routes;
+
+    alignas (16) std::array<std::array<float, numColumns>, numSources> sources {};
+    alignas (16) std::array<std::array<float, numColumns>, numDestinations> destinations {};
+};
@@ -10,37 +10,64 @@
 
 #include "OscData.h"
 
-void OscData::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+namespace
 {
-    resetAll();
+    // Octaves between each partial and the fundamental, for the tilt
+    const std::array<float, HarmonicData::numPartials>& getPartialOctaves()
+    {
+        static const auto octaves = []
+        {
+            std::array<float, HarmonicData::numPartials> result;
+            const auto& partials = HarmonicData::getPartials();
+
+            for (size_t i = 0; i < result.size(); ++i)
+                result[i] = std::log2 (partials[i].ratio);
+
+            return result;
+        }();
+
+        return octaves;
+    }
 
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.sampleRate = sampleRate;
-    spec.numChannels = outputChannels;
+    // Starting phase of each unison copy, spread by the golden ratio so the copies never start in step
+    float getUnisonPhaseOffset (const int copy) noexcept
+    {
+        const auto offset = 0.618034f * (float) copy;
+        return offset - (float) (int) offset;
+    }
+}
+
+template <typename SampleType>
+void OscData<SampleType>::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
+{
+    currentSampleRate = sampleRate;
+    incrementScale = 1;
+    pitchRatio.reset (sampleRate, pitchSmoothingSeconds);
+    setNoteTilt (0.0f);
+    ifftBuffer.assign ((size_t) samplesPerBlock, 0);
+    resetAll();
 
-    prepare (spec);
-    fmOsc.prepare (spec);
-    gain.prepare (spec);
+    ifft.prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
 }
 
-void OscData::setType (const int oscSelection)
+template <typename SampleType>
+void OscData<SampleType>::setType (const int oscSelection)
 {
     switch (oscSelection)
     {
         // Sine
         case 0:
-            initialise ([](float x) { return std::sin (x); });
+            currentWaveform = Waveform::sine;
             break;
 
         // Saw
         case 1:
-            initialise ([] (float x) { return x / juce::MathConstants<float>::pi; });
+            currentWaveform = Waveform::saw;
             break;
 
         // Square
         case 2:
-            initialise ([] (float x) { return x < 0.0f ? -1.0f : 1.0f; });
+            currentWaveform = Waveform::square;
             break;
 
         default:
@@ -50,68 +77,556 @@ void OscData::setType (const int oscSelection)
     }
 }
 
-void OscData::setGain (const float levelInDecibels)
+template <typename SampleType>
+void OscData<SampleType>::setRenderMode (const int modeSelection)
+{
+    switch (modeSelection)
+    {
+        // Oscillator bank
+        case 0:
+            currentRenderMode = RenderMode::oscillators;
+            break;
+
+        // Inverse FFT, sine partials only
+        case 1:
+            if (currentRenderMode != RenderMode::ifft)
+                ifft.reset();
+
+            currentRenderMode = RenderMode::ifft;
+            break;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            break;
+    }
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setGains (const float* partialGains)
+{
+    if (tilt == 0.0f)
+    {
+        for (int i = 0; i < numPartials; ++i)
+            targetGain[(size_t) i] = partialGains[i] * noteTiltGain[(size_t) i];
+    }
+    else
+    {
+        // dB per octave to a power of two per octave
+        const auto& octaves = getPartialOctaves();
+        const auto exponent = tilt * 0.16609640f;
+
+        for (int i = 0; i < numPartials; ++i)
+            targetGain[(size_t) i] = partialGains[i] * noteTiltGain[(size_t) i] * std::exp2 (exponent * octaves[(size_t) i]);
+    }
+
+    if (subharmonicGain != 1.0f)
+        for (int i = 0; i < HarmonicData::fundamentalIndex; ++i)
+            targetGain[(size_t) i] *= subharmonicGain;
+
+    if (overtoneGain != 1.0f)
+        for (int i = HarmonicData::fundamentalIndex + 1; i < numPartials; ++i)
+            targetGain[(size_t) i] *= overtoneGain;
+
+    const auto floor = (SampleType) partialFloor;
+
+    for (auto& g : targetGain)
+        g = g >= floor ? g : 0;
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setSideLevels (const float subharmonicDecibels, const float overtoneDecibels)
+{
+    subharmonicGain = juce::Decibels::decibelsToGain (subharmonicDecibels);
+    overtoneGain = juce::Decibels::decibelsToGain (overtoneDecibels);
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setTilt (const float dbPerOctave)
+{
+    tilt = dbPerOctave;
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setNoteTilt (const float dbPerOctave)
 {
-    gain.setGainDecibels (levelInDecibels);
+    const auto& octaves = getPartialOctaves();
+    const auto exponent = dbPerOctave * 0.16609640f;
+
+    for (int i = 0; i < numPartials; ++i)
+        noteTiltGain[(size_t) i] = juce::jmin (1.0f, std::exp2 (exponent * octaves[(size_t) i]));
 }
 
-void OscData::setOscPitch (const int pitch)
+template <typename SampleType>
+void OscData<SampleType>::setOscPitch (const int pitch)
 {
+    if (pitch == lastPitch)
+        return;
+
     lastPitch = pitch;
-    //setFrequency (juce::MidiMessage::getMidiNoteInHertz ((lastMidiNote + lastPitch) + fmModulator));
+    updatePitchRatio();
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setPitchBend (const float semitones)
+{
+    if (semitones == pitchBend)
+        return;
+
+    pitchBend = semitones;
+    updatePitchRatio();
+}
+
+template <typename SampleType>
+void OscData<SampleType>::updatePitchRatio()
+{
+    pitchRatio.setTargetValue (std::exp2 (((SampleType) lastPitch + (SampleType) pitchBend) / 12));
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setIncrements (const float* partialIncrements)
+{
+    const auto scale = incrementScale;
+    std::transform (partialIncrements, partialIncrements + numPartials, increment.begin(), [scale] (const float i) { return (SampleType) i * scale; });
+
+    // A new note starts at the current pitch instead of gliding there
+    pitchRatio.setCurrentAndTargetValue (pitchRatio.getTargetValue());
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setOversamplingFactor (const int factor)
+{
+    jassert (factor > 0);
+
+    incrementScale = (SampleType) 1 / (SampleType) factor;
+    pitchRatio.reset (currentSampleRate * factor, pitchSmoothingSeconds);
+}
+
+template <typename SampleType>
+void OscData<SampleType>::setUnison (const int numVoices, const float detuneCents, const float spread, const int channel)
+{
+    jassert (juce::isPositiveAndBelow (channel, numChannels));
+
+    const auto voices = juce::jlimit (1, maxUnisonVoices, numVoices);
+
+    if (voices == unisonVoices && channel == unisonChannel && detuneCents == unisonDetune && spread == unisonSpread)
+        return;
+
+    const auto copiesChanged = voices != unisonVoices || channel != unisonChannel;
+
+    unisonVoices = voices;
+    unisonChannel = channel;
+    unisonDetune = detuneCents;
+    unisonSpread = spread;
+    updateUnison();
+
+    if (copiesChanged)
+        resetUnisonPhases();
+}
+
+template <typename SampleType>
+void OscData<SampleType>::updateUnison()
+{
+    laneRatio.fill (1);
+    lanePanLeft.fill (0);
+    lanePanRight.fill (0);
+    maxLaneRatio = 1;
+    numUnisonLanes = 0;
+
+    if (! isUnisonOn())
+        return;
+
+    // The left bank takes the lower half of the copies, and the middle one when there is an odd number
+    const auto firstCopy = unisonChannel == 0 ? 0 : (unisonVoices + 1) / 2;
+    const auto lastCopy = unisonChannel == 0 ? (unisonVoices + 1) / 2 : unisonVoices;
+
+    // Uncorrelated copies add in power
+    const auto copyGain = 1 / std::sqrt ((SampleType) unisonVoices);
+
+    for (int copy = firstCopy; copy < lastCopy; ++copy)
+    {
+        const auto lane = (size_t) numUnisonLanes++;
+
+        // -1 for the lowest copy, 1 for the highest
+        const auto position = 2 * (SampleType) copy / (SampleType) (unisonVoices - 1) - 1;
+
+        laneRatio[lane] = std::exp2 ((SampleType) unisonDetune * position / 1200);
+        maxLaneRatio = juce::jmax (maxLaneRatio, laneRatio[lane]);
+
+        // Equal power pan
+        const auto angle = juce::MathConstants<SampleType>::pi * (SampleType) 0.25 * ((SampleType) unisonSpread * position + 1);
+        lanePanLeft[lane] = copyGain * std::cos (angle);
+        lanePanRight[lane] = copyGain * std::sin (angle);
+    }
+
+    jassert (numUnisonLanes <= numLanes);
+}
+
+template <typename SampleType>
+void OscData<SampleType>::resetUnisonPhases()
+{
+    const auto firstCopy = unisonChannel == 0 ? 0 : (unisonVoices + 1) / 2;
+
+    for (int i = 0; i < numPartials; ++i)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const auto p = phase[(size_t) i] + getUnisonPhaseOffset (firstCopy + lane);
+            lanePhase[(size_t) (i * numLanes + lane)] = p - (SampleType) (int) p;
+        }
+    }
+}
+
+template <typename SampleType>
+void OscData<SampleType>::renderNextBlock (SampleType* output, const int numSamples, const SampleType* phaseModulation, const float* partialEnvelope)
+{
+    jassert (numSamples > 0);
+
+    envelope = partialEnvelope;
+    packActivePartials (numSamples);
+
+    if (currentRenderMode == RenderMode::ifft)
+    {
+        // Hops are longer than the chunks, so the pitch follows once per block
+        const auto ratio = pitchRatio.skip (numSamples);
+
+        for (int i = 0; i < numActive; ++i)
+            activeIncrement[(size_t) i] *= ratio;
+
+        // Gain changes are crossfaded by the overlapping frames
+        ifft.renderNextBlock (output, numSamples, activeIncrement.data(), activeTargetGain.data(), activePhase.data(), numActive);
+    }
+    else if (phaseModulation != nullptr)
+    {
+        switch (currentWaveform)
+        {
+            case Waveform::sine:    renderPartials<Waveform::sine, true> (output, numSamples, phaseModulation);    break;
+            case Waveform::saw:     renderPartials<Waveform::saw, true> (output, numSamples, phaseModulation);     break;
+            case Waveform::square:  renderPartials<Waveform::square, true> (output, numSamples, phaseModulation);  break;
+        }
+    }
+    else
+    {
+        switch (currentWaveform)
+        {
+            case Waveform::sine:    renderPartials<Waveform::sine, false> (output, numSamples, nullptr);    break;
+            case Waveform::saw:     renderPartials<Waveform::saw, false> (output, numSamples, nullptr);     break;
+            case Waveform::square:  renderPartials<Waveform::square, false> (output, numSamples, nullptr);  break;
+        }
+    }
+
+    for (int i = 0; i < numActive; ++i)
+        phase[(size_t) activeIndex[(size_t) i]] = activePhase[(size_t) i];
+
+    currentGain = targetGain;
+}
+
+template <typename SampleType>
+void OscData<SampleType>::renderNextBlock (SampleType* left, SampleType* right, const int numSamples, const SampleType* phaseModulation, const float* partialEnvelope)
+{
+    jassert (numSamples > 0);
+    jassert (isUnisonOn());
+
+    envelope = partialEnvelope;
+    packActivePartials (numSamples);
+
+    if (currentRenderMode == RenderMode::ifft)
+    {
+        renderUnisonIfft (left, right, numSamples);
+    }
+    else if (phaseModulation != nullptr)
+    {
+        switch (currentWaveform)
+        {
+            case Waveform::sine:    renderUnison<Waveform::sine, true> (left, right, numSamples, phaseModulation);    break;
+            case Waveform::saw:     renderUnison<Waveform::saw, true> (left, right, numSamples, phaseModulation);     break;
+            case Waveform::square:  renderUnison<Waveform::square, true> (left, right, numSamples, phaseModulation);  break;
+        }
+    }
+    else
+    {
+        switch (currentWaveform)
+        {
+            case Waveform::sine:    renderUnison<Waveform::sine, false> (left, right, numSamples, nullptr);    break;
+            case Waveform::saw:     renderUnison<Waveform::saw, false> (left, right, numSamples, nullptr);     break;
+            case Waveform::square:  renderUnison<Waveform::square, false> (left, right, numSamples, nullptr);  break;
+        }
+    }
+
+    for (int i = 0; i < numActive; ++i)
+    {
+        const auto from = (size_t) (i * numLanes);
+        const auto to = (size_t) (activeIndex[(size_t) i] * numLanes);
+        std::copy (activeLanePhase.begin() + from, activeLanePhase.begin() + from + numLanes, lanePhase.begin() + to);
+    }
+
+    currentGain = targetGain;
+}
+
+template <typename SampleType>
+void OscData<SampleType>::packActivePartials (const int numSamples)
+{
+    const auto rampScale = 1 / (SampleType) numSamples;
+    const auto unisonRatio = isUnisonOn() ? maxLaneRatio : (SampleType) 1;
+    const auto maxRatio = unisonRatio * juce::jmax (pitchRatio.getCurrentValue(), pitchRatio.getTargetValue());
+    numActive = 0;
+
+    // Envelope levels at the start and end of the block
+    const auto* envelopeStart = envelope;
+    const auto* envelopeEnd = envelope != nullptr ? envelope + ((numSamples + chunkSize - 1) / chunkSize) * numPartials : nullptr;
+
+    for (int i = 0; i < numPartials; ++i)
+    {
+        // Silent partials and partials bent or transposed past Nyquist cost nothing
+        if (increment[(size_t) i] <= 0.0f || increment[(size_t) i] * maxRatio >= 0.5f
+            || (targetGain[(size_t) i] <= 0.0f && currentGain[(size_t) i] <= 0.0f))
+            continue;
+
+        // Nor do partials whose envelope has finished, or not started
+        if (envelope != nullptr && envelopeStart[i] <= 0.0f && envelopeEnd[i] <= 0.0f)
+            continue;
+
+        const auto n = (size_t) numActive++;
+        activeIndex[n] = i;
+        activePhase[n] = phase[(size_t) i];
+        activeIncrement[n] = increment[(size_t) i];
+        activeGain[n] = currentGain[(size_t) i];
+        activeGainStep[n] = (targetGain[(size_t) i] - currentGain[(size_t) i]) * rampScale;
+        activeTargetGain[n] = targetGain[(size_t) i];
+
+        // The IFFT takes one gain per block
+        if (envelope != nullptr)
+            activeTargetGain[n] *= envelopeEnd[i];
+    }
+
+    if (isUnisonOn())
+    {
+        for (int i = 0; i < numActive; ++i)
+        {
+            const auto from = (size_t) (activeIndex[(size_t) i] * numLanes);
+            std::copy (lanePhase.begin() + from, lanePhase.begin() + from + numLanes, activeLanePhase.begin() + i * numLanes);
+        }
+    }
+}
+
+template <typename SampleType>
+std::pair<SampleType, SampleType> OscData<SampleType>::getChunkRamp (const int activePartial, const int chunk, const int numInChunk) const noexcept
+{
+    const auto gain0 = activeGain[(size_t) activePartial];
+    const auto gainStep = activeGainStep[(size_t) activePartial];
+
+    if (envelope == nullptr)
+        return { gain0, gainStep };
+
+    const auto* edge = envelope + chunk * numPartials + activeIndex[(size_t) activePartial];
+    const auto gainEnd = (gain0 + (SampleType) numInChunk * gainStep) * (SampleType) edge[numPartials];
+    const auto gainStart = gain0 * (SampleType) edge[0];
 
+    return { gainStart, (gainEnd - gainStart) / (SampleType) numInChunk };
 }
 
-void OscData::setFreq (const int midiNoteNumber)
+template <typename SampleType>
+template <typename OscData<SampleType>::Waveform waveform, bool phaseModulated>
+void OscData<SampleType>::renderPartials (SampleType* output, const int numSamples, const SampleType* phaseModulation)
 {
-    //setFrequency (juce::MidiMessage::getMidiNoteInHertz ((midiNoteNumber + lastPitch) + fmModulator));
-    setFrequency(juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber));
-    lastMidiNote = midiNoteNumber;
-}
-
-void OscData::setSubFreq (const int midiNoteNumber, int subharmonic)
-{
-    setFrequency (juce:: MidiMessage::getMidiNoteInHertz (midiNoteNumber) / subharmonic);
-    lastMidiNote = midiNoteNumber;
-}
-
-void OscData::setHarmonicFreq (const int midiNoteNumber, int harmonic)
-{
-    setFrequency (juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) * harmonic);
-    lastMidiNote = midiNoteNumber;
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto numInChunk = juce::jmin (chunkSize, numSamples - start);
+        auto* out = output + start;
+
+        // Bends and transposition are one multiply per partial per chunk
+        const auto ratio = pitchRatio.skip (numInChunk);
+
+        for (int i = 0; i < numActive; ++i)
+        {
+            const auto phase0 = activePhase[(size_t) i];
+            const auto inc = activeIncrement[(size_t) i] * ratio;
+            const auto [gain0, gainStep] = getChunkRamp (i, start / chunkSize, numInChunk);
+
+            for (int s = 0; s < numInChunk; ++s)
+            {
+                auto p = phase0 + (SampleType) s * inc;
+
+                if constexpr (phaseModulated)
+                    p += phaseModulation[start + s];
+
+                p -= (SampleType) (int) p;
+                out[s] += (gain0 + (SampleType) s * gainStep) * getWaveform<waveform> (p);
+            }
+
+            const auto nextPhase = phase0 + (SampleType) numInChunk * inc;
+            activePhase[(size_t) i] = nextPhase - (SampleType) (int) nextPhase;
+            activeGain[(size_t) i] += (SampleType) numInChunk * activeGainStep[(size_t) i];
+        }
+    }
 }
 
-void OscData::setFmOsc (const float freq, const float depth)
+template <typename SampleType>
+template <typename OscData<SampleType>::Waveform waveform, bool phaseModulated>
+void OscData<SampleType>::renderUnison (SampleType* left, SampleType* right, const int numSamples, const SampleType* phaseModulation)
 {
-    fmDepth = depth;
-    fmOsc.setFrequency (freq);
-    //setFrequency (juce::MidiMessage::getMidiNoteInHertz ((lastMidiNote + lastPitch) + fmModulator));
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto numInChunk = juce::jmin (chunkSize, numSamples - start);
+        const auto ratio = pitchRatio.skip (numInChunk);
+
+        std::fill (laneSum.begin(), laneSum.begin() + numInChunk * numLanes, 0.0f);
+
+        for (int i = 0; i < numActive; ++i)
+        {
+            auto* phase0 = activeLanePhase.data() + i * numLanes;
+            const auto [gain0, gainStep] = getChunkRamp (i, start / chunkSize, numInChunk);
+
+            alignas (16) std::array<SampleType, numLanes> inc;
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                inc[(size_t) lane] = activeIncrement[(size_t) i] * ratio * laneRatio[(size_t) lane];
+
+            // All copies of the partial at once; the lane loop has a fixed trip count and becomes one vector
+            for (int s = 0; s < numInChunk; ++s)
+            {
+                const auto gain = gain0 + (SampleType) s * gainStep;
+                auto* sum = laneSum.data() + s * numLanes;
+                SampleType modulation = 0;
+
+                if constexpr (phaseModulated)
+                    modulation = phaseModulation[start + s];
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    auto p = phase0[lane] + (SampleType) s * inc[(size_t) lane] + modulation;
+                    p -= (SampleType) (int) p;
+                    sum[lane] += gain * getWaveform<waveform> (p);
+                }
+            }
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                const auto nextPhase = phase0[lane] + (SampleType) numInChunk * inc[(size_t) lane];
+                phase0[lane] = nextPhase - (SampleType) (int) nextPhase;
+            }
+
+            activeGain[(size_t) i] += (SampleType) numInChunk * activeGainStep[(size_t) i];
+        }
+
+        for (int s = 0; s < numInChunk; ++s)
+        {
+            const auto* sum = laneSum.data() + s * numLanes;
+            SampleType l = 0;
+            SampleType r = 0;
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                l += lanePanLeft[(size_t) lane] * sum[lane];
+                r += lanePanRight[(size_t) lane] * sum[lane];
+            }
+
+            left[start + s] += l;
+            right[start + s] += r;
+        }
+    }
 }
 
-void OscData::renderNextBlock (juce::dsp::AudioBlock<float>& audioBlock)
+template <typename SampleType>
+void OscData<SampleType>::renderUnisonIfft (SampleType* left, SampleType* right, const int numSamples)
 {
-    jassert (audioBlock.getNumSamples() > 0);
-    process (juce::dsp::ProcessContextReplacing<float> (audioBlock));
-    gain.process (juce::dsp::ProcessContextReplacing<float> (audioBlock));
+    jassert (numSamples <= (int) ifftBuffer.size());
+
+    const auto ratio = pitchRatio.skip (numSamples);
+
+    // Every copy is a partial of its own to the IFFT; unused lanes are silent
+    for (int i = 0; i < numActive; ++i)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const auto n = (size_t) (i * numLanes + lane);
+            activeLaneIncrement[n] = activeIncrement[(size_t) i] * ratio * laneRatio[(size_t) lane];
+            activeLaneGain[n] = lane < numUnisonLanes ? activeTargetGain[(size_t) i] : 0.0f;
+        }
+    }
+
+    std::fill (ifftBuffer.begin(), ifftBuffer.begin() + numSamples, 0.0f);
+    ifft.renderNextBlock (ifftBuffer.data(), numSamples, activeLaneIncrement.data(), activeLaneGain.data(), activeLanePhase.data(), numActive * numLanes);
+
+    // One transform per bank, so its copies share the average of their pans
+    SampleType panLeft = 0;
+    SampleType panRight = 0;
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        panLeft += lanePanLeft[(size_t) lane];
+        panRight += lanePanRight[(size_t) lane];
+    }
+
+    panLeft /= (SampleType) numUnisonLanes;
+    panRight /= (SampleType) numUnisonLanes;
+
+    juce::FloatVectorOperations::addWithMultiply (left, ifftBuffer.data(), panLeft, numSamples);
+    juce::FloatVectorOperations::addWithMultiply (right, ifftBuffer.data(), panRight, numSamples);
 }
 
-float OscData::processNextSample (float input)
+template <typename SampleType>
+template <typename OscData<SampleType>::Waveform waveform>
+SampleType OscData<SampleType>::getWaveform (const SampleType phase) noexcept
 {
-    //fmModulator = fmOsc.processSample (input) * fmDepth;
-    return gain.processSample (processSample (input));
+    // Phase 0 is the start of the juce::dsp::Oscillator cycle, x = -pi
+    const auto t = phase - (SampleType) 0.5;
+
+    if constexpr (waveform == Waveform::sine)
+    {
+        // Fold onto a quarter cycle, then a Taylor series
+        const auto u = std::copysign ((SampleType) 0.25 - std::abs (std::abs (t) - (SampleType) 0.25), t);
+        const auto x = juce::MathConstants<SampleType>::twoPi * u;
+        const auto x2 = x * x;
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            // 9th order, error below 4e-6
+            return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+        }
+        else
+        {
+            // 17th order, error below 1e-11
+            auto sum = (SampleType) 1 / 355687428096000.0;
+            sum = (SampleType) -1 / 1307674368000.0 + x2 * sum;
+            sum = (SampleType) 1 / 6227020800.0 + x2 * sum;
+            sum = (SampleType) -1 / 39916800.0 + x2 * sum;
+            sum = (SampleType) 1 / 362880.0 + x2 * sum;
+            sum = (SampleType) -1 / 5040.0 + x2 * sum;
+            sum = (SampleType) 1 / 120.0 + x2 * sum;
+            sum = (SampleType) -1 / 6.0 + x2 * sum;
+            return x * (1 + x2 * sum);
+        }
+    }
+    else if constexpr (waveform == Waveform::saw)
+    {
+        return 2 * t;
+    }
+    else
+    {
+        return t < 0 ? (SampleType) -1 : (SampleType) 1;
+    }
 }
 
-void OscData::setParams (const int oscChoice, const float oscGain, const int oscPitch, const float fmFreq, const float fmDepth)
+template <typename SampleType>
+void OscData<SampleType>::setParams (const int oscChoice, const int renderMode, const float* partialGains, const int oscPitch)
 {
     setType (oscChoice);
-    setGain (oscGain);
+    setRenderMode (renderMode);
+    setGains (partialGains);
     setOscPitch (oscPitch);
-    setFmOsc (fmFreq, fmDepth);
 }
 
-void OscData::resetAll()
+template <typename SampleType>
+void OscData<SampleType>::resetAll()
 {
-    reset();
-    fmOsc.reset();
-    gain.reset();
+    phase.fill (0.0f);
+    currentGain.fill (0.0f);
+    numActive = 0;
+    resetUnisonPhases();
+    pitchRatio.setCurrentAndTargetValue (pitchRatio.getTargetValue());
+    ifft.reset();
 }
+
+template class OscData<float>;
+template class OscData<double>;
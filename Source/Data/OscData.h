@@ -11,32 +11,188 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "HarmonicData.h"
+#include "IfftOscData.h"
+#include "PartialEnvelopeData.h"
 
-class OscData : public juce::dsp::Oscillator<float>
+// Additive oscillator bank holding every partial of the HarmonicData table.
+// State is kept as separate arrays per field, and once per block the partials
+// that can be heard are packed densely so the render loop only visits those.
+// Each partial's phase and gain are evaluated in closed form over short
+// chunks, which leaves the inner loop free of loop-carried dependencies so
+// the compiler can vectorise it. In IFFT mode the packed partials are handed
+// to IfftOscData instead, whose cost depends on the FFT size rather than on
+// the number of partials.
+//
+// Unison copies of every partial sit side by side in SIMD lanes and are
+// evaluated together. The copies are shared out between the two banks of a
+// voice, the lower half to the left channel's bank and the upper half to the
+// right's, and each bank plays its copies into both outputs at their pans.
+//
+// Gains under the silence floor, whether set that low or tilted down to it,
+// are zeroed as they are set and so drop out of the packed partials.
+//
+// Per-partial envelope levels come in once per chunk and are folded into the
+// gain ramp, so they add nothing to the inner loop.
+//
+// FM is phase modulation of every partial by one modulator per voice, which
+// the voice renders and passes in as a phase offset per sample. The IFFT
+// mode only updates phases once per hop and leaves it out.
+//
+// The sample type is the host's processing precision. Parameters stay float;
+// phases, increments and gains are held at the sample type, so a double
+// precision bank keeps long drones in phase.
+template <typename SampleType>
+class OscData
 {
 public:
+    static constexpr int maxUnisonVoices { 8 };
+
     void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
     void setType (const int oscSelection);
-    void setGain (const float levelInDecibels);
+    void setRenderMode (const int modeSelection);
+    void setGains (const float* partialGains);
+
+    // Gain under which partials are dropped, from the next setGains() on; never below the silence floor
+    void setPartialFloor (const float gain) { partialFloor = juce::jmax (silenceFloor, gain); }
+    void setTilt (const float dbPerOctave);
+
+    // Offsets in dB for every subharmonic and every overtone
+    void setSideLevels (const float subharmonicDecibels, const float overtoneDecibels);
+
+    // Set once per note from its key and velocity. It only ever cuts, so the
+    // partials on the side it tilts away from are left at their drawbar gains.
+    void setNoteTilt (const float dbPerOctave);
     void setOscPitch (const int pitch);
-    void setFreq (const int midiNoteNumber);
-    void setSubFreq(const int midiNoteNumber, int subharmonic);
-    void setHarmonicFreq(const int midiNoteNumber, int harmonic);
-    void setFmOsc (const float freq, const float depth);
-    void renderNextBlock (juce::dsp::AudioBlock<float>& audioBlock);
-    float processNextSample (float input);
-    void setParams (const int oscChoice, const float oscGain, const int oscPitch, const float fmFreq, const float fmDepth);
+    void setPitchBend (const float semitones);
+    void setIncrements (const float* partialIncrements);
+
+    // Renders factor samples for every sample at the prepared rate, from the next setIncrements() on
+    void setOversamplingFactor (const int factor);
+
+    // Cycles per sample of the fundamental at the current pitch, for a modulator to lock to
+    SampleType getFundamentalIncrement() const noexcept { return increment[(size_t) HarmonicData::fundamentalIndex] * pitchRatio.getCurrentValue(); }
+
+    // phaseModulation is added to every partial's phase, in cycles and never
+    // negative. partialEnvelope holds the levels from PartialEnvelopeData::process().
+    // Either can be nullptr.
+    void renderNextBlock (SampleType* output, const int numSamples, const SampleType* phaseModulation, const float* partialEnvelope);
+
+    // channel picks which half of the copies this bank plays; detune is the
+    // offset of the outermost copies in cents and spread is 0 to 1
+    void setUnison (const int numVoices, const float detuneCents, const float spread, const int channel);
+    bool isUnisonOn() const { return unisonVoices > 1; }
+
+    // Only while unison is on; adds this bank's copies to both outputs
+    void renderNextBlock (SampleType* left, SampleType* right, const int numSamples, const SampleType* phaseModulation, const float* partialEnvelope);
+
+    void setParams (const int oscChoice, const int renderMode, const float* partialGains, const int oscPitch);
     void resetAll();
 
+    int getNumActivePartials() const { return numActive; }
+
 private:
-    juce::dsp::Oscillator<float> fmOsc { [](float x) { return std::sin (x); }};
-    juce::dsp::Gain<float> gain;
+    enum class Waveform
+    {
+        sine,
+        saw,
+        square
+    };
+
+    enum class RenderMode
+    {
+        oscillators,
+        ifft
+    };
+
+    static constexpr int numPartials { HarmonicData::numPartials };
+    static constexpr int numChannels { 2 };
+    static constexpr int numLanes { maxUnisonVoices / numChannels };
+
+    // Short enough that phase0 + s * increment stays accurate in single precision
+    static constexpr int chunkSize { 64 };
+    static_assert (chunkSize == PartialEnvelopeData::controlBlockSize, "Envelope levels are given per chunk");
+    static constexpr double pitchSmoothingSeconds { 0.01 };
+
+    // -100 dB, the bottom of the drawbars
+    static constexpr float silenceFloor { 1.0e-5f };
+
+    template <Waveform waveform, bool phaseModulated>
+    void renderPartials (SampleType* output, const int numSamples, const SampleType* phaseModulation);
+
+    template <Waveform waveform, bool phaseModulated>
+    void renderUnison (SampleType* left, SampleType* right, const int numSamples, const SampleType* phaseModulation);
+
+    void renderUnisonIfft (SampleType* left, SampleType* right, const int numSamples);
+
+    template <Waveform waveform>
+    static SampleType getWaveform (const SampleType phase) noexcept;
+
+    void packActivePartials (const int numSamples);
+
+    // Gain at the start of a chunk and its step per sample, with the envelope folded in
+    std::pair<SampleType, SampleType> getChunkRamp (const int activePartial, const int chunk, const int numInChunk) const noexcept;
+    void updatePitchRatio();
+    void updateUnison();
+    void resetUnisonPhases();
+
+    Waveform currentWaveform { Waveform::sine };
+    RenderMode currentRenderMode { RenderMode::oscillators };
+
+    // Every partial, in table order. Phases are in cycles, [0, 1).
+    std::array<SampleType, numPartials> phase {};
+    std::array<SampleType, numPartials> increment {};
+    std::array<SampleType, numPartials> currentGain {};
+    std::array<SampleType, numPartials> targetGain {};
+
+    // Audible partials only, packed at the front
+    int numActive { 0 };
+    std::array<int, numPartials> activeIndex {};
+    alignas (32) std::array<SampleType, numPartials> activePhase {};
+    alignas (32) std::array<SampleType, numPartials> activeIncrement {};
+    alignas (32) std::array<SampleType, numPartials> activeGain {};
+    alignas (32) std::array<SampleType, numPartials> activeGainStep {};
+    alignas (32) std::array<SampleType, numPartials> activeTargetGain {};
+
+    // Only valid during a render
+    const float* envelope { nullptr };
+
+    // Unison copies owned by this bank, one lane each; unused lanes have no pan gain
+    int unisonVoices { 1 };
+    int unisonChannel { 0 };
+    int numUnisonLanes { 0 };
+    float unisonDetune { 0.0f };
+    float unisonSpread { 0.0f };
+    SampleType maxLaneRatio { 1 };
+    alignas (16) std::array<SampleType, numLanes> laneRatio {};
+    alignas (16) std::array<SampleType, numLanes> lanePanLeft {};
+    alignas (16) std::array<SampleType, numLanes> lanePanRight {};
+
+    // Partial i, copy l at i * numLanes + l
+    alignas (16) std::array<SampleType, numPartials * numLanes> lanePhase {};
+    alignas (16) std::array<SampleType, numPartials * numLanes> activeLanePhase {};
+    alignas (16) std::array<SampleType, numPartials * numLanes> activeLaneIncrement {};
+    alignas (16) std::array<SampleType, numPartials * numLanes> activeLaneGain {};
+
+    // Each lane summed over the partials, mixed down to left and right once per chunk
+    alignas (16) std::array<SampleType, chunkSize * numLanes> laneSum {};
+    std::vector<SampleType> ifftBuffer;
+
+    IfftOscData<SampleType> ifft;
+
+    // The table's increments are per sample at the host rate
+    double currentSampleRate { 44100.0 };
+    SampleType incrementScale { 1 };
+
+    // Transposition and bend scale every increment by one smoothed ratio
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> pitchRatio { 1 };
     int lastPitch { 0 };
-    int lastMidiNote { 0 };
-    float fmDepth { 0.0f };
-    float fmModulator { 0.0f };
-};
+    float pitchBend { 0.0f };
 
-// return std::sin (x); //Sine Wave
-// return x / MathConstants<float>::pi; // Saw Wave
-// return x < 0.0f ? -1.0f : 1.0f;  // Square Wave
+    // Applied to the gains as they are set, relative to the fundamental
+    float tilt { 0.0f };
+    std::array<float, numPartials> noteTiltGain {};
+    float subharmonicGain { 1.0f };
+    float overtoneGain { 1.0f };
+    float partialFloor { silenceFloor };
+};
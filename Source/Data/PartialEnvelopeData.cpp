@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    PartialEnvelopeData.cpp
+    Created: 19 Oct 2026 9:12:37pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "PartialEnvelopeData.h"
+
+namespace
+{
+    // The attack aims past full scale so it arrives in its set time instead of creeping up to it
+    constexpr float attackTarget { 1.2f };
+
+    // Decay and release cover all but -60 dB of their distance in their set time
+    constexpr float segmentDepth { 6.9077553f };
+
+    // Released partials below -80 dB are finished and stop being rendered
+    constexpr float silenceLevel { 1.0e-4f };
+}
+
+void PartialEnvelopeData::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    levels.assign ((size_t) ((samplesPerBlock / controlBlockSize + 2) * numPartials), 0.0f);
+
+    // Forces the coefficients to be worked out at the new rate
+    attackTime = -1.0f;
+    reset();
+}
+
+void PartialEnvelopeData::setSampleRate (double sampleRate)
+{
+    if (sampleRate == currentSampleRate)
+        return;
+
+    currentSampleRate = sampleRate;
+
+    // Until the first setParams() there is nothing to work out
+    if (attackTime >= 0.0f)
+        updateCoefficients();
+}
+
+void PartialEnvelopeData::setParams (const bool enabled, const float attackSeconds, const float decaySeconds, const float sustain, const float releaseSeconds, const float scaling)
+{
+    if (enabled != isOn)
+    {
+        isOn = enabled;
+        reset();
+    }
+
+    if (attackSeconds == attackTime && decaySeconds == decayTime && sustain == sustainLevel && releaseSeconds == releaseTime && scaling == timeScaling)
+        return;
+
+    attackTime = attackSeconds;
+    decayTime = decaySeconds;
+    sustainLevel = sustain;
+    releaseTime = releaseSeconds;
+    timeScaling = scaling;
+    updateCoefficients();
+}
+
+void PartialEnvelopeData::updateCoefficients()
+{
+    const auto& partials = HarmonicData::getPartials();
+    const auto attackDepth = std::log (attackTarget / (attackTarget - 1.0f));
+
+    for (int i = 0; i < numPartials; ++i)
+    {
+        const auto timeScale = std::exp2 (-timeScaling * std::log2 (partials[(size_t) i].ratio));
+        const auto samplesPerSecond = (float) currentSampleRate * timeScale;
+
+        const auto getCoefficient = [samplesPerSecond] (const float seconds, const float depth)
+        {
+            return std::exp (-depth / juce::jmax (1.0f, seconds * samplesPerSecond));
+        };
+
+        std::array<float, 4> sampleCoefficient {};
+        sampleCoefficient[attack] = getCoefficient (attackTime, attackDepth);
+        sampleCoefficient[decay] = getCoefficient (decayTime, segmentDepth);
+        sampleCoefficient[release] = getCoefficient (releaseTime, segmentDepth);
+        sampleCoefficient[idle] = 1.0f;
+
+        // Multiplied up in double so a whole block matches std::pow to float precision
+        for (size_t s = 0; s < sampleCoefficient.size(); ++s)
+        {
+            auto power = (double) sampleCoefficient[s];
+
+            for (auto& row : coefficientPowers[s])
+            {
+                row[(size_t) i] = (float) power;
+                power *= sampleCoefficient[s];
+            }
+        }
+    }
+
+    // Partials already in a segment pick up its new time and target
+    for (int i = 0; i < numPartials; ++i)
+        enterStage (i, (Stage) stage[(size_t) i]);
+}
+
+void PartialEnvelopeData::enterStage (const int partial, const Stage newStage)
+{
+    const auto i = (size_t) partial;
+    stage[i] = newStage;
+    coefficient[i] = coefficientPowers[newStage][controlBlockSize - 1][i];
+
+    switch (newStage)
+    {
+        case idle:      target[i] = 0.0f;           break;
+        case attack:    target[i] = attackTarget;   break;
+        case decay:     target[i] = sustainLevel;   break;
+        case release:   target[i] = 0.0f;           break;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            break;
+    }
+}
+
+void PartialEnvelopeData::noteOn()
+{
+    // Retriggered partials start from where they are
+    for (int i = 0; i < numPartials; ++i)
+        enterStage (i, attack);
+}
+
+void PartialEnvelopeData::noteOff()
+{
+    for (int i = 0; i < numPartials; ++i)
+        if (stage[(size_t) i] != idle)
+            enterStage (i, release);
+}
+
+void PartialEnvelopeData::reset()
+{
+    level.fill (0.0f);
+
+    for (int i = 0; i < numPartials; ++i)
+        enterStage (i, idle);
+}
+
+const float* PartialEnvelopeData::process (const int numSamples)
+{
+    if (! isOn)
+        return nullptr;
+
+    jassert ((size_t) ((numSamples / controlBlockSize + 2) * numPartials) <= levels.size());
+
+    auto* row = levels.data();
+    std::copy (level.begin(), level.end(), row);
+
+    for (int start = 0; start < numSamples; start += controlBlockSize)
+    {
+        advance (juce::jmin (controlBlockSize, numSamples - start));
+        row += numPartials;
+        std::copy (level.begin(), level.end(), row);
+    }
+
+    return levels.data();
+}
+
+void PartialEnvelopeData::advance (const int numSamples)
+{
+    // A short last block takes its coefficients from its own row of the table
+    if (numSamples != controlBlockSize)
+    {
+        const auto n = (size_t) (numSamples - 1);
+
+        for (int i = 0; i < numPartials; ++i)
+            coefficient[(size_t) i] = coefficientPowers[(size_t) stage[(size_t) i]][n][(size_t) i];
+    }
+
+    // Closed form over the whole block, with no branches so it vectorises
+    for (int i = 0; i < numPartials; ++i)
+        level[(size_t) i] = target[(size_t) i] + (level[(size_t) i] - target[(size_t) i]) * coefficient[(size_t) i];
+
+    // Segment ends are only looked for at block edges
+    for (int i = 0; i < numPartials; ++i)
+    {
+        const auto s = (size_t) i;
+
+        if (stage[s] == attack && level[s] >= 1.0f)
+        {
+            level[s] = 1.0f;
+            enterStage (i, decay);
+        }
+        else if (stage[s] == release && level[s] < silenceLevel)
+        {
+            level[s] = 0.0f;
+            enterStage (i, idle);
+        }
+        else if (numSamples != controlBlockSize)
+        {
+            coefficient[s] = coefficientPowers[(size_t) stage[s]][controlBlockSize - 1][s];
+        }
+    }
+}
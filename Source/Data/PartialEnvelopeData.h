@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    PartialEnvelopeData.h
+    Created: 19 Oct 2026 9:12:37pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "HarmonicData.h"
+
+// An ADSR for every partial of a voice, on top of the voice's amplitude
+// envelope. All partials share one shape, with times scaled by each
+// partial's ratio so higher partials can move faster than lower ones.
+//
+// State is kept as separate arrays per field. Every segment is an
+// exponential approach to a target, so one control block is a single
+// multiply-add per partial with a coefficient worked out when the
+// parameters change, for every block length up to a whole control block. The levels at the control block edges are handed to
+// OscData, which ramps between them inside its partial loop.
+class PartialEnvelopeData
+{
+public:
+    static constexpr int numPartials { HarmonicData::numPartials };
+
+    // Same as the chunks OscData renders in
+    static constexpr int controlBlockSize { 64 };
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock);
+
+    // For a voice that changes its oversampling; samplesPerBlock must already cover the new rate
+    void setSampleRate (double sampleRate);
+
+    // Times in seconds; scaling is how many times shorter every segment gets
+    // per octave of partial ratio, as a power of two
+    void setParams (const bool enabled, const float attackSeconds, const float decaySeconds, const float sustain, const float releaseSeconds, const float scaling);
+
+    void noteOn();
+    void noteOff();
+    void reset();
+
+    // Levels at the start of every control block of the next numSamples and
+    // at its end, one row of numPartials each. nullptr while switched off.
+    const float* process (const int numSamples);
+
+private:
+    enum Stage
+    {
+        idle = 0,
+        attack,
+        decay,
+        release
+    };
+
+    void updateCoefficients();
+    void advance (const int numSamples);
+    void enterStage (const int partial, const Stage newStage);
+
+    double currentSampleRate { 44100.0 };
+    bool isOn { false };
+    float attackTime { -1.0f };
+    float decayTime { -1.0f };
+    float sustainLevel { -1.0f };
+    float releaseTime { -1.0f };
+    float timeScaling { 0.0f };
+
+    // Per stage, every partial's per-sample coefficient raised to the powers
+    // 1 to controlBlockSize, so a block of n samples uses row n - 1
+    std::array<std::array<std::array<float, numPartials>, controlBlockSize>, 4> coefficientPowers {};
+
+    std::array<int, numPartials> stage {};
+    alignas (32) std::array<float, numPartials> level {};
+    alignas (32) std::array<float, numPartials> target {};
+    alignas (32) std::array<float, numPartials> coefficient {};
+
+    // One row per control block edge
+    std::vector<float> levels;
+};
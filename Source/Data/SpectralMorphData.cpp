@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    SpectralMorphData.cpp
+    Created: 19 Oct 2026 10:04:51pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "SpectralMorphData.h"
+
+SpectralMorphData::SpectralMorphData()
+{
+    // Slots that have not been stored yet hold the default drawbars
+    const auto& partials = HarmonicData::getPartials();
+
+    for (auto& snapshot : snapshotDecibels)
+        for (int i = 0; i < numPartials; ++i)
+            snapshot[(size_t) i] = partials[(size_t) i].defaultGain;
+}
+
+void SpectralMorphData::setSnapshot (const int slot, const float* decibels)
+{
+    jassert (juce::isPositiveAndBelow (slot, numSnapshots));
+
+    std::copy (decibels, decibels + numPartials, snapshotDecibels[(size_t) slot].begin());
+    numStored = juce::jmax (numStored, slot + 1);
+
+    auto next = std::make_unique<Table>();
+    next->numToMorph = juce::jmax (2, numStored);
+
+    for (int s = 0; s < next->numToMorph; ++s)
+        for (int i = 0; i < numPartials; ++i)
+            next->gain[(size_t) s][(size_t) i] = juce::Decibels::decibelsToGain (snapshotDecibels[(size_t) s][(size_t) i], HarmonicData::minGain);
+
+    for (int s = 0; s < next->numToMorph - 1; ++s)
+        for (int i = 0; i < numPartials; ++i)
+            next->difference[(size_t) s][(size_t) i] = next->gain[(size_t) s + 1][(size_t) i] - next->gain[(size_t) s][(size_t) i];
+
+    // The table this one replaces was picked up by an earlier block
+    table.collectGarbage();
+    table.publish (std::move (next));
+}
+
+bool SpectralMorphData::process (const float position, float* gains) noexcept
+{
+    const auto* current = table.acquire();
+
+    if (current == nullptr)
+        return false;
+
+    const auto x = juce::jlimit (0.0f, 1.0f, position) * (float) (current->numToMorph - 1);
+    const auto lower = juce::jmin ((int) x, current->numToMorph - 2);
+    const auto fraction = x - (float) lower;
+
+    juce::FloatVectorOperations::copy (gains, current->gain[(size_t) lower].data(), numPartials);
+    juce::FloatVectorOperations::addWithMultiply (gains, current->difference[(size_t) lower].data(), fraction, numPartials);
+    return true;
+}
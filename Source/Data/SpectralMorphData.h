@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    SpectralMorphData.h
+    Created: 19 Oct 2026 10:04:51pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AtomicSwap.h"
+#include "HarmonicData.h"
+
+// Snapshots of every partial gain, morphed through by one position. Stored
+// snapshots are converted from dB once, on the message thread, together with
+// the difference from each snapshot to the next. A morph step on the audio
+// thread is then one vector lerp between two neighbouring snapshots.
+//
+// The morph runs from the first snapshot to the last one stored, so storing A
+// and B morphs between the two and storing C as well extends the range to it.
+class SpectralMorphData
+{
+public:
+    static constexpr int numSnapshots { 4 };
+    static constexpr int numPartials { HarmonicData::numPartials };
+
+    SpectralMorphData();
+
+    // Message thread. One gain in dB per partial.
+    void setSnapshot (const int slot, const float* decibels);
+
+    // Audio thread. Writes the linear gains at position 0..1 and returns
+    // false, leaving gains untouched, before the first snapshot is stored.
+    bool process (const float position, float* gains) noexcept;
+
+private:
+    struct Table
+    {
+        int numToMorph { 2 };
+        std::array<std::array<float, numPartials>, numSnapshots> gain {};
+        std::array<std::array<float, numPartials>, numSnapshots> difference {};
+    };
+
+    AtomicSwap<Table> table;
+
+    // Message thread
+    std::array<std::array<float, numPartials>, numSnapshots> snapshotDecibels {};
+    int numStored { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectralMorphData)
+};
@@ -0,0 +1,520 @@
+/*
+  ==============================================================================
+
+    TuningData.cpp
+    Created: 19 Oct 2026 6:20:14pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "TuningData.h"
+
+namespace
+{
+    // Partials of a tuned church bell above the prime: tierce, quint, nominal,
+    // deciem, undeciem, duodeciem, double octave and the upper partials
+    constexpr std::array<float, 10> bellRatios { 1.2f, 1.5f, 2.0f, 2.5f, 2.667f, 3.0f, 4.0f, 5.333f, 6.0f, 8.0f };
+
+    // Roots of cos (b) cosh (b) = 1, the modes of a bar free at both ends
+    constexpr std::array<double, 4> barRoots { 4.730041, 7.853205, 10.995608, 14.137165 };
+
+    double getBarRoot (const int mode)
+    {
+        // Past the first few the roots are (2 mode + 1) pi / 2 to double precision
+        return mode < (int) barRoots.size() ? barRoots[(size_t) mode]
+                                            : (2 * mode + 3) * juce::MathConstants<double>::halfPi;
+    }
+
+    int floorDivide (const int value, const int divisor)
+    {
+        return value >= 0 ? value / divisor : -((divisor - 1 - value) / divisor);
+    }
+
+    // Scale degrees wrap around at the period, the last entry of the scale
+    double getDegreeCents (const std::vector<double>& scale, const int degree)
+    {
+        const auto numDegrees = (int) scale.size() - 1;
+        const auto periods = floorDivide (degree, numDegrees);
+        return periods * scale.back() + scale[(size_t) (degree - periods * numDegrees)];
+    }
+
+    // Lines of a Scala file with the comments removed
+    juce::StringArray getScalaLines (const juce::String& text)
+    {
+        juce::StringArray lines;
+
+        for (const auto& line : juce::StringArray::fromLines (text))
+            if (! line.startsWithChar ('!'))
+                lines.add (line.trim());
+
+        return lines;
+    }
+
+    // A pitch is in cents if it has a period, otherwise it is a ratio or an integer
+    bool parseScalaPitch (const juce::String& line, double& cents)
+    {
+        const auto pitch = line.upToFirstOccurrenceOf (" ", false, false).upToFirstOccurrenceOf ("\t", false, false);
+
+        if (pitch.containsChar ('.'))
+        {
+            cents = pitch.getDoubleValue();
+            return true;
+        }
+
+        const auto numerator = pitch.upToFirstOccurrenceOf ("/", false, false).getDoubleValue();
+        const auto denominator = pitch.containsChar ('/') ? pitch.fromFirstOccurrenceOf ("/", false, false).getDoubleValue() : 1.0;
+
+        if (numerator <= 0.0 || denominator <= 0.0)
+            return false;
+
+        cents = 1200.0 * std::log2 (numerator / denominator);
+        return true;
+    }
+
+    // MTS frequency data: a note number and a 14 bit fraction of a semitone above it
+    double getTuningFrequency (const juce::uint8* data)
+    {
+        const auto semitones = data[0] + ((data[1] << 7) | data[2]) / 16384.0;
+        return 440.0 * std::pow (2.0, (semitones - 69.0) / 12.0);
+    }
+
+    bool isNoChange (const juce::uint8* data)
+    {
+        return data[0] == 0x7f && data[1] == 0x7f && data[2] == 0x7f;
+    }
+}
+
+TuningData::TuningData() : juce::Thread ("Partial Tuning")
+{
+    const auto& partials = HarmonicData::getPartials();
+
+    for (size_t i = 0; i < ratios.size(); ++i)
+        ratios[i].store (partials[i].ratio);
+
+    for (int step = 0; step <= 12; ++step)
+        scaleCents.push_back (100.0 * step);
+
+    for (int note = 0; note < numNotes; ++note)
+    {
+        noteFrequencies[(size_t) note] = juce::MidiMessage::getMidiNoteInHertz (note);
+        frequencies[(size_t) note].store ((float) noteFrequencies[(size_t) note]);
+    }
+}
+
+TuningData::~TuningData()
+{
+    stopThread (2000);
+}
+
+void TuningData::prepareToPlay (double sampleRate)
+{
+    stopThread (2000);
+
+    currentSampleRate = sampleRate;
+    builtCount = requestCount.load();
+
+    // Nothing is rendering yet, so the first table can be built right here
+    table.collectGarbage();
+    table.publish (createIncrementTable());
+
+    startThread();
+}
+
+void TuningData::setParams (const int series, const float stretch)
+{
+    if (series == requestedSeries.load (std::memory_order_relaxed) && stretch == requestedStretch.load (std::memory_order_relaxed))
+        return;
+
+    requestedSeries.store (series, std::memory_order_relaxed);
+    requestedStretch.store (stretch, std::memory_order_relaxed);
+    requestCount.fetch_add (1, std::memory_order_release);
+    notify();
+}
+
+void TuningData::processMidi (const juce::MidiBuffer& midiMessages)
+{
+    auto queued = false;
+
+    for (const auto metadata : midiMessages)
+    {
+        const auto message = metadata.getMessage();
+
+        if (! message.isSysEx())
+            continue;
+
+        // Universal real time or non real time, MIDI tuning standard
+        const auto* data = message.getSysExData();
+        const auto size = message.getSysExDataSize();
+
+        if (size < 4 || size > maxSysExSize || (data[0] != 0x7e && data[0] != 0x7f) || data[2] != 0x08)
+            continue;
+
+        // Dropped if the builder has fallen this far behind
+        if (sysExFifo.getFreeSpace() == 0)
+            break;
+
+        int start1, size1, start2, size2;
+        sysExFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        auto& slot = sysExMessages[(size_t) start1];
+        slot.size = size;
+        std::copy (data, data + size, slot.data.begin());
+
+        sysExFifo.finishedWrite (1);
+        queued = true;
+    }
+
+    if (queued)
+        notify();
+}
+
+void TuningData::loadUserRatios (const juce::File& file)
+{
+    std::vector<float> loaded;
+
+    for (const auto& token : juce::StringArray::fromTokens (file.loadFileAsString(), true))
+    {
+        const auto ratio = token.getFloatValue();
+
+        if (ratio > 0.0f && (int) loaded.size() < numOvertones)
+            loaded.push_back (ratio);
+    }
+
+    {
+        const juce::ScopedLock lock (settingsLock);
+        userRatios = std::move (loaded);
+    }
+
+    requestCount.fetch_add (1, std::memory_order_release);
+    notify();
+}
+
+void TuningData::loadScale (const juce::File& file)
+{
+    std::vector<double> cents;
+
+    if (parseScale (file.loadFileAsString(), cents))
+    {
+        scaleCents = std::move (cents);
+        updateNoteFrequencies();
+    }
+}
+
+void TuningData::loadKeyboardMapping (const juce::File& file)
+{
+    KeyboardMapping mapping;
+
+    if (parseKeyboardMapping (file.loadFileAsString(), mapping))
+    {
+        keyboardMapping = std::move (mapping);
+        updateNoteFrequencies();
+    }
+}
+
+void TuningData::updateNoteFrequencies()
+{
+    const auto& mapping = keyboardMapping;
+
+    // Cents of a note relative to the middle note, false if the note is not mapped
+    auto getNoteCents = [this, &mapping] (const int note, double& cents)
+    {
+        const auto offset = note - mapping.middleNote;
+
+        if (mapping.size == 0)
+        {
+            cents = getDegreeCents (scaleCents, offset);
+            return true;
+        }
+
+        const auto repeats = floorDivide (offset, mapping.size);
+        const auto index = (size_t) (offset - repeats * mapping.size);
+        const auto degree = index < mapping.keys.size() ? mapping.keys[index] : -1;
+
+        if (degree < 0)
+            return false;
+
+        cents = repeats * getDegreeCents (scaleCents, mapping.octaveDegree) + getDegreeCents (scaleCents, degree);
+        return true;
+    };
+
+    auto referenceCents = 0.0;
+
+    // A mapping that leaves its own reference note out cannot be used
+    if (! getNoteCents (mapping.referenceNote, referenceCents))
+        return;
+
+    std::array<double, numNotes> tuned;
+
+    for (int note = 0; note < numNotes; ++note)
+    {
+        auto cents = 0.0;
+        const auto mapped = note >= mapping.firstNote && note <= mapping.lastNote && getNoteCents (note, cents);
+        tuned[(size_t) note] = mapped ? mapping.referenceFrequency * std::pow (2.0, (cents - referenceCents) / 1200.0) : 0.0;
+    }
+
+    {
+        const juce::ScopedLock lock (settingsLock);
+        noteFrequencies = tuned;
+    }
+
+    requestCount.fetch_add (1, std::memory_order_release);
+    notify();
+}
+
+bool TuningData::applyTuningMessage (const juce::uint8* data, const int size)
+{
+    const juce::ScopedLock lock (settingsLock);
+
+    // Sets every note from equal temperament plus a cents offset per pitch class
+    auto applyOctaveTuning = [this] (auto getCents)
+    {
+        for (int note = 0; note < numNotes; ++note)
+            noteFrequencies[(size_t) note] = 440.0 * std::pow (2.0, (note - 69 + getCents (note % 12) / 100.0) / 12.0);
+    };
+
+    auto applyNoteChanges = [this, data, size] (const int first, const int count)
+    {
+        for (int i = 0; i < count && first + 4 * i + 4 <= size; ++i)
+        {
+            const auto* change = data + first + 4 * i;
+
+            if (change[0] < numNotes && ! isNoChange (change + 1))
+                noteFrequencies[change[0]] = getTuningFrequency (change + 1);
+        }
+    };
+
+    // Tuning programs and banks are not kept apart; every message retunes the one table
+    switch (data[3])
+    {
+        // Bulk dump: program, 16 character name, 128 notes, checksum
+        case 0x01:
+            if (size < 21 + 3 * numNotes)
+                return false;
+
+            for (int note = 0; note < numNotes; ++note)
+                if (! isNoChange (data + 21 + 3 * note))
+                    noteFrequencies[(size_t) note] = getTuningFrequency (data + 21 + 3 * note);
+
+            return true;
+
+        // Single note change: program, count, then note and frequency for each
+        case 0x02:
+            if (size < 6)
+                return false;
+
+            applyNoteChanges (6, data[5]);
+            return true;
+
+        // Single note change with bank: bank, program, count, then the changes
+        case 0x07:
+            if (size < 7)
+                return false;
+
+            applyNoteChanges (7, data[6]);
+            return true;
+
+        // Scale/octave tuning, one byte per pitch class: channel mask, 12 offsets of -64 to 63 cents
+        case 0x08:
+            if (size < 19)
+                return false;
+
+            applyOctaveTuning ([data] (const int pitchClass) { return data[7 + pitchClass] - 64.0; });
+            return true;
+
+        // Scale/octave tuning, two bytes per pitch class: 14 bit offsets of -100 to 100 cents
+        case 0x09:
+            if (size < 31)
+                return false;
+
+            applyOctaveTuning ([data] (const int pitchClass)
+            {
+                const auto value = (data[7 + 2 * pitchClass] << 7) | data[8 + 2 * pitchClass];
+                return (value - 8192) * 100.0 / 8192.0;
+            });
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool TuningData::parseScale (const juce::String& text, std::vector<double>& cents)
+{
+    const auto lines = getScalaLines (text);
+
+    // Description, number of pitches, then one pitch per line
+    if (lines.size() < 2)
+        return false;
+
+    const auto numPitches = lines[1].getIntValue();
+
+    if (numPitches < 1 || lines.size() < 2 + numPitches)
+        return false;
+
+    cents = { 0.0 };
+
+    for (int i = 0; i < numPitches; ++i)
+    {
+        auto pitch = 0.0;
+
+        if (! parseScalaPitch (lines[2 + i], pitch))
+            return false;
+
+        cents.push_back (pitch);
+    }
+
+    return true;
+}
+
+bool TuningData::parseKeyboardMapping (const juce::String& text, KeyboardMapping& mapping)
+{
+    auto lines = getScalaLines (text);
+    lines.removeEmptyStrings();
+
+    // Seven header fields, then one scale degree or x per key
+    if (lines.size() < 7)
+        return false;
+
+    mapping.size = lines[0].getIntValue();
+    mapping.firstNote = lines[1].getIntValue();
+    mapping.lastNote = lines[2].getIntValue();
+    mapping.middleNote = lines[3].getIntValue();
+    mapping.referenceNote = lines[4].getIntValue();
+    mapping.referenceFrequency = lines[5].getDoubleValue();
+    mapping.octaveDegree = lines[6].getIntValue();
+
+    if (mapping.size < 0 || mapping.referenceFrequency <= 0.0
+        || ! juce::isPositiveAndBelow (mapping.referenceNote, numNotes)
+        || ! juce::isPositiveAndBelow (mapping.middleNote, numNotes))
+        return false;
+
+    // Keys past the end of a short list are not mapped
+    for (int i = 0; i < mapping.size; ++i)
+    {
+        const auto key = 7 + i < lines.size() ? lines[7 + i] : juce::String ("x");
+        mapping.keys.push_back (key.startsWithIgnoreCase ("x") ? -1 : key.getIntValue());
+    }
+
+    return true;
+}
+
+void TuningData::run()
+{
+    while (! threadShouldExit())
+    {
+        const auto numMessages = sysExFifo.getNumReady();
+
+        for (int i = 0; i < numMessages; ++i)
+        {
+            int start1, size1, start2, size2;
+            sysExFifo.prepareToRead (1, start1, size1, start2, size2);
+
+            const auto& message = sysExMessages[(size_t) start1];
+
+            if (applyTuningMessage (message.data.data(), message.size))
+                requestCount.fetch_add (1, std::memory_order_release);
+
+            sysExFifo.finishedRead (1);
+        }
+
+        const auto requested = requestCount.load (std::memory_order_acquire);
+
+        if (requested != builtCount)
+        {
+            builtCount = requested;
+            table.publish (createIncrementTable());
+        }
+
+        // The audio thread never holds on to a replaced table, so it can be freed here
+        table.collectGarbage();
+        wait (50);
+    }
+}
+
+std::unique_ptr<TuningData::IncrementTable> TuningData::createIncrementTable()
+{
+    const auto series = (Series) requestedSeries.load (std::memory_order_relaxed);
+    const auto stretch = requestedStretch.load (std::memory_order_relaxed);
+
+    std::vector<float> user;
+    std::array<double, numNotes> noteHz;
+
+    {
+        const juce::ScopedLock lock (settingsLock);
+        user = userRatios;
+        noteHz = noteFrequencies;
+    }
+
+    std::array<float, HarmonicData::numPartials> partialRatios;
+    partialRatios[(size_t) HarmonicData::fundamentalIndex] = 1.0f;
+
+    for (int n = 1; n <= numOvertones; ++n)
+    {
+        const auto ratio = getOvertoneRatio (series, n, stretch, user);
+        partialRatios[(size_t) (HarmonicData::fundamentalIndex + n)] = ratio;
+
+        if (n <= HarmonicData::maxSubharmonics)
+            partialRatios[(size_t) (HarmonicData::fundamentalIndex - n)] = 1.0f / ratio;
+    }
+
+    auto newTable = std::make_unique<IncrementTable>();
+
+    for (int note = 0; note < numNotes; ++note)
+    {
+        const auto noteIncrement = noteHz[(size_t) note] / currentSampleRate;
+        auto& row = newTable->increment[(size_t) note];
+
+        // Partials at or above Nyquist get no increment and are never packed
+        for (size_t i = 0; i < row.size(); ++i)
+        {
+            const auto partialIncrement = (float) (noteIncrement * partialRatios[i]);
+            row[i] = partialIncrement < 0.5f ? partialIncrement : 0.0f;
+        }
+    }
+
+    for (size_t i = 0; i < ratios.size(); ++i)
+        ratios[i].store (partialRatios[i], std::memory_order_relaxed);
+
+    for (size_t i = 0; i < frequencies.size(); ++i)
+        frequencies[i].store ((float) noteHz[i], std::memory_order_relaxed);
+
+    return newTable;
+}
+
+float TuningData::getOvertoneRatio (const Series series, const int overtone, const float stretch, const std::vector<float>& user)
+{
+    const auto harmonic = (float) (overtone + 1);
+
+    switch (series)
+    {
+        case Series::harmonic:
+            return harmonic;
+
+        // Every octave widened by the stretch, as in piano tuning
+        case Series::stretched:
+            return std::pow (harmonic, 1.0f + stretch / 1200.0f);
+
+        // Past the table the modes spread out with the square of their number
+        case Series::bell:
+        {
+            const auto last = (int) bellRatios.size();
+
+            if (overtone <= last)
+                return bellRatios[(size_t) (overtone - 1)];
+
+            return bellRatios.back() * juce::square ((float) overtone / (float) last);
+        }
+
+        case Series::bar:
+            return (float) juce::square (getBarRoot (overtone) / getBarRoot (0));
+
+        case Series::user:
+            return overtone <= (int) user.size() ? user[(size_t) (overtone - 1)] : harmonic;
+
+        default:
+            // You shouldn't be here!
+            jassertfalse;
+            return harmonic;
+    }
+}
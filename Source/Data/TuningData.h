@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    TuningData.h
+    Created: 19 Oct 2026 6:20:14pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AtomicSwap.h"
+#include "HarmonicData.h"
+
+// Owns the phase increment of every partial for every MIDI note. A table is
+// built on a background thread whenever the partial series or the note
+// tuning changes and is swapped in for the audio thread, so a note-on only
+// copies one row and the render loop never sees which series or tuning is
+// selected.
+//
+// Overtone n of a series has its own ratio; subharmonic n uses the
+// reciprocal, which gives the usual 1 / (n + 1) for the harmonic series.
+//
+// Notes are tuned by a Scala scale (.scl) and keyboard mapping (.kbm), or
+// retuned by MIDI Tuning Standard SysEx. Tuning messages are queued by the
+// audio thread and applied by the builder thread.
+class TuningData : private juce::Thread
+{
+public:
+    enum class Series
+    {
+        harmonic,
+        stretched,
+        bell,
+        bar,
+        user
+    };
+
+    static constexpr int numNotes { 128 };
+
+    struct IncrementTable
+    {
+        // Cycles per sample; 0 for partials at or above Nyquist
+        std::array<std::array<float, HarmonicData::numPartials>, numNotes> increment {};
+    };
+
+    TuningData();
+    ~TuningData() override;
+
+    void prepareToPlay (double sampleRate);
+
+    // Audio thread. The stretch is in cents per octave and only applies to the stretched series.
+    void setParams (const int series, const float stretch);
+    const IncrementTable* getIncrementTable() noexcept { return table.acquire(); }
+
+    // Audio thread. Queues the MIDI Tuning Standard messages in the buffer.
+    void processMidi (const juce::MidiBuffer& midiMessages);
+
+    // Message thread. Whitespace separated overtone ratios; missing ones stay harmonic.
+    void loadUserRatios (const juce::File& file);
+
+    // Message thread. Files that cannot be parsed are ignored.
+    void loadScale (const juce::File& file);
+    void loadKeyboardMapping (const juce::File& file);
+
+    // Frequency of a note in the table that was built last, 0 if unmapped
+    float getNoteFrequency (const int note) const noexcept { return frequencies[(size_t) note].load (std::memory_order_relaxed); }
+
+    // Ratio of the table that was built last, for display
+    float getRatio (const int index) const noexcept { return ratios[(size_t) index].load (std::memory_order_relaxed); }
+
+private:
+    // Scala keyboard mapping; the default maps the scale linearly from note 60, with note 69 at 440 Hz
+    struct KeyboardMapping
+    {
+        int size { 0 };
+        int firstNote { 0 };
+        int lastNote { numNotes - 1 };
+        int middleNote { 60 };
+        int referenceNote { 69 };
+        double referenceFrequency { 440.0 };
+        int octaveDegree { 0 };
+
+        // Scale degree of each key, -1 for keys that are not mapped
+        std::vector<int> keys;
+    };
+
+    static constexpr int numOvertones { HarmonicData::maxOvertones };
+    static constexpr int maxSysExSize { 512 };
+    static constexpr int numSysExSlots { 16 };
+
+    struct SysExMessage
+    {
+        int size { 0 };
+        std::array<juce::uint8, maxSysExSize> data {};
+    };
+
+    void run() override;
+    std::unique_ptr<IncrementTable> createIncrementTable();
+    static float getOvertoneRatio (const Series series, const int overtone, const float stretch, const std::vector<float>& user);
+
+    void updateNoteFrequencies();
+    bool applyTuningMessage (const juce::uint8* data, const int size);
+    static bool parseScale (const juce::String& text, std::vector<double>& cents);
+    static bool parseKeyboardMapping (const juce::String& text, KeyboardMapping& mapping);
+
+    double currentSampleRate { 0.0 };
+
+    AtomicSwap<IncrementTable> table;
+    std::array<std::atomic<float>, HarmonicData::numPartials> ratios;
+    std::array<std::atomic<float>, numNotes> frequencies;
+
+    // Written by the audio and message threads, read by the builder
+    std::atomic<int> requestedSeries { 0 };
+    std::atomic<float> requestedStretch { 0.0f };
+    std::atomic<int> requestCount { 0 };
+    int builtCount { 0 };
+
+    juce::CriticalSection settingsLock;
+    std::vector<float> userRatios;
+    std::array<double, numNotes> noteFrequencies;
+
+    // Message thread; cents of each scale degree from 0 up to the period
+    std::vector<double> scaleCents;
+    KeyboardMapping keyboardMapping;
+
+    // Tuning SysEx, from the audio thread to the builder
+    juce::AbstractFifo sysExFifo { numSysExSlots };
+    std::array<SysExMessage, numSysExSlots> sysExMessages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TuningData)
+};
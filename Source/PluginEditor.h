@@ -16,8 +16,10 @@
 #include "UI/LfoComponent.h"
 #include "UI/ReverbComponent.h"
 #include "UI/MeterComponent.h"
+#include "UI/AnalyzerComponent.h"
 #include "UI/Assets.h"
-#include "UI/HarmonicComponent.h"
+#include "UI/DrawbarComponent.h"
+#include "UI/ModMatrixComponent.h"
 
 //==============================================================================
 /**
@@ -38,30 +40,15 @@ public:
 private:
     TapSynthAudioProcessor& audioProcessor;
     OscComponent osc1;
-    HarmonicComponent sub1;
-    HarmonicComponent sub2;
-    HarmonicComponent sub3;
-    HarmonicComponent sub4;
-    HarmonicComponent sub5;
-    HarmonicComponent sub6;
-    HarmonicComponent sub7;
-    HarmonicComponent sub8;
-    HarmonicComponent sub9;
-    HarmonicComponent ov1;
-    HarmonicComponent ov2;
-    HarmonicComponent ov3;
-    HarmonicComponent ov4;
-    HarmonicComponent ov5;
-    HarmonicComponent ov6;
-    HarmonicComponent ov7;
-    HarmonicComponent ov8;
-    HarmonicComponent ov9;
+    DrawbarComponent harmonics;
     FilterComponent filter;
     AdsrComponent adsr;
     LfoComponent lfo1;
     AdsrComponent filterAdsr;
     ReverbComponent reverb;
     MeterComponent meter;
+    AnalyzerComponent analyzer;
+    ModMatrixComponent modMatrix;
     juce::ImageComponent logo;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TapSynthAudioProcessorEditor)
@@ -23,17 +23,44 @@ TapSynthAudioProcessor::TapSynthAudioProcessor()
                        ), apvts (*this, nullptr, "Parameters", createParams())
 #endif
 {
-    synth.addSound (new SynthSound());
+    synth.addSound (new SynthSound (expression));
 
-    for (int i = 0; i < 5; i++)
+    for (int i = 0; i < numVoices; i++)
     {
-        synth.addVoice (new SynthVoice());
+        synth.addSynthVoice (new SynthVoice (expression, lfos, i));
     }
+
+    const auto& partials = HarmonicData::getPartials();
+
+    for (size_t i = 0; i < partials.size(); ++i)
+        partialGainParams[i] = apvts.getRawParameterValue (partials[i].paramId);
+
+    for (int r = 0; r < ModMatrixData::maxRoutes; ++r)
+    {
+        const auto route = "MOD" + juce::String (r + 1);
+        modSourceParams[(size_t) r] = apvts.getRawParameterValue (route + "SOURCE");
+        modDestinationParams[(size_t) r] = apvts.getRawParameterValue (route + "DEST");
+        modDepthParams[(size_t) r] = apvts.getRawParameterValue (route + "DEPTH");
+    }
+
+    for (int n = 0; n < LfoData::numLfos; ++n)
+    {
+        const auto lfo = "LFO" + juce::String (n + 1);
+        auto& p = lfoParams[(size_t) n];
+        p.frequency = apvts.getRawParameterValue (lfo + "FREQ");
+        p.shape = apvts.getRawParameterValue (lfo + "SHAPE");
+        p.sync = apvts.getRawParameterValue (lfo + "SYNC");
+        p.division = apvts.getRawParameterValue (lfo + "DIVISION");
+        p.mode = apvts.getRawParameterValue (lfo + "MODE");
+    }
+
+    apvts.addParameterListener ("OVERSAMPLING", this);
 }
 
 TapSynthAudioProcessor::~TapSynthAudioProcessor()
 {
-
+    apvts.removeParameterListener ("OVERSAMPLING", this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -102,14 +129,19 @@ void TapSynthAudioProcessor::changeProgramName (int index, const juce::String& n
 void TapSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     synth.setCurrentPlaybackSampleRate (sampleRate);
+    tuning.prepareToPlay (sampleRate);
+    expression.prepareToPlay (sampleRate);
+    lfos.prepareToPlay (sampleRate);
+    governor.prepareToPlay (sampleRate, samplesPerBlock);
 
-    for (int i = 0; i < synth.getNumVoices(); i++)
+    synth.forEachVoice ([&] (int, SynthVoice& voice)
     {
-        if (auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-        {
-            voice->prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
-        }
-    }
+        voice.prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    });
+
+    // Reported again, as the latency depends on the rate
+    setOversampling ((int) apvts.getRawParameterValue ("OVERSAMPLING")->load());
+    updateLatency();
 
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
@@ -124,6 +156,12 @@ void TapSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     reverbParams.wetLevel = 0.0f;
 
     reverb.setParameters (reverbParams);
+    reverb.prepare (spec);
+    fdnReverb.prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    convolution.prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    meter.prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    analyzer.prepareToPlay (sampleRate);
+    effectsBuffer.setSize (getTotalNumOutputChannels(), samplesPerBlock);
 }
 
 void TapSynthAudioProcessor::releaseResources()
@@ -156,23 +194,117 @@ bool TapSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 }
 #endif
 
+bool TapSynthAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
 void TapSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    process (buffer, midiMessages);
+}
+
+void TapSynthAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    process (buffer, midiMessages);
+}
+
+template <typename SampleType>
+void TapSynthAudioProcessor::process (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    juce::AudioProcessLoadMeasurer::ScopedTimer loadTimer (governor.getLoadMeasurer(), buffer.getNumSamples());
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
+    tuning.processMidi (midiMessages);
+
+    // Expression is sampled once per block, before the voices read it
+    expression.setParams (apvts.getRawParameterValue ("MPE")->load() > 0.5f);
+    expression.processMidi (midiMessages);
+    expression.advance (buffer.getNumSamples());
+
+    // Quality for this block, from the load of the ones before it. A bounce
+    // has no deadline, so it always renders at full quality.
+    if (isNonRealtime())
+        governor.holdFullQuality();
+    else
+        governor.update (buffer.getNumSamples());
+
+    auto numNoteOns = 0;
+
+    for (const auto metadata : midiMessages)
+    {
+        if (metadata.getMessage().isNoteOn())
+        {
+            analyzer.setFundamental (tuning.getNoteFrequency (metadata.getMessage().getNoteNumber()));
+            ++numNoteOns;
+        }
+    }
+
+    // Idle voices only get their parameters once a note is about to start on them
+    voicesToUpdate = synth.getVoicesToUpdate (numNoteOns);
+
+    playPosition.resetToDefault();
+
+    if (auto* playHead = getPlayHead())
+        playHead->getCurrentPosition (playPosition);
+
     setParams();
 
-    synth.renderNextBlock (buffer, midiMessages, 0, buffer.getNumSamples());
-    juce::dsp::AudioBlock<float> block { buffer };
-    reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+    // The render is split into control blocks, and the synth splits those further at MIDI events
+    for (int start = 0; start < buffer.getNumSamples(); start += controlBlockSize)
+    {
+        const auto numToRender = juce::jmin (controlBlockSize, buffer.getNumSamples() - start);
+
+        updateModulation (start, numToRender);
+        setVoiceModulation();
+        setFilterParams();
+        synth.renderNextBlock (buffer, midiMessages, start, numToRender);
+    }
+
+    // The voices keep their phases in double precision; the effects and meters work on a float copy
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        processEffects (buffer);
+    }
+    else
+    {
+        effectsBuffer.makeCopyOf (buffer, true);
+        processEffects (effectsBuffer);
+        buffer.makeCopyOf (effectsBuffer, true);
+    }
+}
+
+void TapSynthAudioProcessor::processEffects (juce::AudioBuffer<float>& buffer)
+{
+    switch ((int) *apvts.getRawParameterValue ("REVERBENGINE"))
+    {
+        case 0:
+        {
+            juce::dsp::AudioBlock<float> block { buffer };
+            reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+            break;
+        }
+
+        case 1:
+            fdnReverb.processNextBlock (buffer);
+            break;
+
+        case 2:
+            convolution.processNextBlock (buffer);
+            break;
+
+        default:
+            jassertfalse;
+            break;
+    }
 
-    meter.processRMS (buffer);
-    meter.processPeak (buffer);
+    meter.processNextBlock (buffer);
+    analyzer.pushNextBlock (buffer);
 }
 
 //==============================================================================
@@ -214,60 +346,114 @@ juce::AudioProcessorValueTreeState::ParameterLayout TapSynthAudioProcessor::crea
     // OSC select
     params.push_back (std::make_unique<juce::AudioParameterChoice> ("OSC1", "Oscillator 1", juce::StringArray { "Sine", "Saw", "Square" }, 0));
 
+    // OSC render mode
+    params.push_back (std::make_unique<juce::AudioParameterChoice> ("OSC1MODE", "Oscillator 1 Mode", juce::StringArray { "Oscillators", "IFFT" }, 0));
+
     // OSC Gain
     params.push_back (std::make_unique<juce::AudioParameterFloat>("OSC1GAIN", "Oscillator 1 Gain", juce::NormalisableRange<float> { -40.0f, 0.2f, 0.1f }, -20.0, "dB"));
 
     // OSC Pitch val
     params.push_back (std::make_unique<juce::AudioParameterInt>("OSC1PITCH", "Oscillator 1 Pitch", -48, 48, 0));
 
-    // FM Osc Freq
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OSC1FMFREQ", "Oscillator 1 FM Frequency", juce::NormalisableRange<float> { 0.0f, 1000.0f, 0.1f }, 0.0f, "Hz"));
+    // FM modulator frequency, as a ratio of the fundamental
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("OSC1FMRATIO", "Oscillator 1 FM Ratio", juce::NormalisableRange<float> { 0.25f, 16.0f, 0.01f, 0.5f }, 1.0f, ""));
+
+    // Partial ratio series
+    params.push_back (std::make_unique<juce::AudioParameterChoice> ("PARTIALSERIES", "Partial Series", juce::StringArray { "Harmonic", "Stretched", "Bell", "Bar", "User" }, 0));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PARTIALSTRETCH", "Partial Stretch", juce::NormalisableRange<float> { -100.0f, 100.0f, 0.1f }, 0.0f, "ct"));
+
+    // Spectral morph through the stored drawbar snapshots
+    params.push_back (std::make_unique<juce::AudioParameterBool>("MORPHON", "Spectral Morph", false));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("MORPH", "Morph Position", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.001f }, 0.0f, ""));
+
+    // Per-partial envelope; scaling shortens the segments of higher partials, as a power of two per octave
+    params.push_back (std::make_unique<juce::AudioParameterBool>("PARTIALENV", "Partial Envelopes", false));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PARTIALATTACK", "Partial Attack", juce::NormalisableRange<float> { 0.0f, 5.0f, 0.001f, 0.3f }, 0.01f, "s"));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PARTIALDECAY", "Partial Decay", juce::NormalisableRange<float> { 0.0f, 10.0f, 0.001f, 0.3f }, 1.0f, "s"));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PARTIALSUSTAIN", "Partial Sustain", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.01f }, 0.5f, ""));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PARTIALRELEASE", "Partial Release", juce::NormalisableRange<float> { 0.0f, 10.0f, 0.001f, 0.3f }, 0.5f, "s"));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PARTIALENVSCALE", "Partial Envelope Scaling", juce::NormalisableRange<float> { -1.0f, 1.0f, 0.01f }, 0.5f, ""));
 
-    //SubOscillator Gain
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB1GAIN", "Subharmonic 1 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB2GAIN", "Subharmonic 2 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB3GAIN", "Subharmonic 3 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1 }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB4GAIN", "Subharmonic 4 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB5GAIN", "Subharmonic 5 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1 }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB6GAIN", "Subharmonic 6 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1 }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB7GAIN", "Subharmonic 7 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1 }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB8GAIN", "Subharmonic 8 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1 }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("SUB9GAIN", "Subharmonic 9 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1 }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV1GAIN", "Overtone 1 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV2GAIN", "Overtone 2 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV3GAIN", "Overtone 3 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV4GAIN", "Overtone 4 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV5GAIN", "Overtone 5 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV6GAIN", "Overtone 6 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV7GAIN", "Overtone 7 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV8GAIN", "Overtone 8 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OV9GAIN", "Overtone 9 Gain", juce::NormalisableRange<float> { -100.0f, 0.2f, 0.1f }, -20.0f, "dB"));
+    // Unison
+    params.push_back (std::make_unique<juce::AudioParameterInt>("UNISON", "Unison Voices", 1, OscData<float>::maxUnisonVoices, 1));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("UNISONDETUNE", "Unison Detune", juce::NormalisableRange<float> { 0.0f, 100.0f, 0.1f }, 15.0f, "ct"));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("UNISONSPREAD", "Unison Spread", juce::NormalisableRange<float> { 0.0f, 100.0f, 0.1f }, 50.0f, "%"));
 
+    // MPE, and where pressure and slide go
+    params.push_back (std::make_unique<juce::AudioParameterBool>("MPE", "MPE", false));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("PRESSURETILT", "Pressure Tilt", juce::NormalisableRange<float> { -12.0f, 12.0f, 0.1f }, 0.0f, "dB/oct"));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("SLIDECUTOFF", "Slide Cutoff", juce::NormalisableRange<float> { 0.0f, 4.0f, 0.01f }, 1.0f, "oct"));
 
+    // Tilt set at note-on: per octave of key from middle C, and for a note at zero velocity
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("KEYTILT", "Key Tilt", juce::NormalisableRange<float> { -12.0f, 12.0f, 0.1f }, 0.0f, "dB/oct"));
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("VELOCITYTILT", "Velocity Tilt", juce::NormalisableRange<float> { 0.0f, 12.0f, 0.1f }, 0.0f, "dB/oct"));
+
+    // Subharmonic and overtone gains, one per entry of the partial table
+    const auto& partials = HarmonicData::getPartials();
+
+    for (int i = 0; i < HarmonicData::numPartials; ++i)
+    {
+        // The fundamental is OSC1GAIN above, with its own range
+        if (HarmonicData::isFundamental (i))
+            continue;
+
+        const auto& partial = partials[(size_t) i];
+
+        params.push_back (std::make_unique<juce::AudioParameterFloat>(partial.paramId, partial.paramName, juce::NormalisableRange<float> { HarmonicData::minGain, HarmonicData::maxGain, 0.1f }, partial.defaultGain, "dB"));
+    }
 
-    // FM Osc Depth
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("OSC1FMDEPTH", "Oscillator 1 FM Depth", juce::NormalisableRange<float> { 0.0f, 100.0f, 0.1f }, 0.0f, ""));
+    // FM Osc Depth, the peak phase deviation of every partial
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("OSC1FMDEPTH", "Oscillator 1 FM Depth", juce::NormalisableRange<float> { 0.0f, 10.0f, 0.01f }, 0.0f, "rad"));
+
+    // LFOs; a synced LFO runs at its division of the host tempo instead of its frequency
+    for (int n = 1; n <= LfoData::numLfos; ++n)
+    {
+        const auto lfo = "LFO" + juce::String (n);
+
+        params.push_back (std::make_unique<juce::AudioParameterFloat>(lfo + "FREQ", lfo + " Frequency", juce::NormalisableRange<float> { 0.0f, 20.0f, 0.1f }, 0.0f, "Hz"));
+        params.push_back (std::make_unique<juce::AudioParameterChoice>(lfo + "SHAPE", lfo + " Shape", LfoData::getShapeNames(), 0));
+        params.push_back (std::make_unique<juce::AudioParameterBool>(lfo + "SYNC", lfo + " Sync", false));
+        params.push_back (std::make_unique<juce::AudioParameterChoice>(lfo + "DIVISION", lfo + " Division", LfoData::getDivisionNames(), 4));
+        params.push_back (std::make_unique<juce::AudioParameterChoice>(lfo + "MODE", lfo + " Mode", juce::StringArray { "Global", "Per Voice" }, 0));
+    }
 
-    // LFO
-    params.push_back (std::make_unique<juce::AudioParameterFloat>("LFO1FREQ", "LFO1 Frequency", juce::NormalisableRange<float> { 0.0f, 20.0f, 0.1f }, 0.0f, "Hz"));
+    // LFO 1 to the filter cutoff, in Hz
     params.push_back (std::make_unique<juce::AudioParameterFloat>("LFO1DEPTH", "LFO1 Depth", juce::NormalisableRange<float> { 0.0f, 10000.0f, 0.1f, 0.3f }, 0.0f, ""));
 
+    // Modulation matrix; depth is a proportion of the destination's range
+    for (int r = 1; r <= ModMatrixData::maxRoutes; ++r)
+    {
+        const auto route = juce::String (r);
+
+        params.push_back (std::make_unique<juce::AudioParameterChoice>("MOD" + route + "SOURCE", "Mod " + route + " Source", ModMatrixData::getSourceNames(), 0));
+        params.push_back (std::make_unique<juce::AudioParameterChoice>("MOD" + route + "DEST", "Mod " + route + " Destination", ModMatrixData::getDestinationNames(), 0));
+        params.push_back (std::make_unique<juce::AudioParameterFloat>("MOD" + route + "DEPTH", "Mod " + route + " Depth", juce::NormalisableRange<float> { -1.0f, 1.0f, 0.01f }, 0.0f, ""));
+    }
+
     //Filter
     params.push_back (std::make_unique<juce::AudioParameterChoice>("FILTERTYPE", "Filter Type", juce::StringArray { "Low Pass", "Band Pass", "High Pass" }, 0));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERCUTOFF", "Filter Cutoff", juce::NormalisableRange<float> { 20.0f, 20000.0f, 0.1f, 0.6f }, 20000.0f, "Hz"));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERRESONANCE", "Filter Resonance", juce::NormalisableRange<float> { 0.1f, 2.0f, 0.1f }, 0.1f, ""));
 
+    // Oscillators and filter at a multiple of the host rate, against the aliasing of saw, square and high resonance
+    params.push_back (std::make_unique<juce::AudioParameterChoice>("OVERSAMPLING", "Oversampling", juce::StringArray { "Off", "2x", "4x", "8x" }, 0));
+
     // ADSR
     params.push_back (std::make_unique<juce::AudioParameterFloat>("ATTACK", "Attack", juce::NormalisableRange<float> { 0.1f, 1.0f, 0.1f }, 0.1f));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("DECAY", "Decay", juce::NormalisableRange<float> { 0.1f, 1.0f, 0.1f }, 0.1f));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("SUSTAIN", "Sustain", juce::NormalisableRange<float> { 0.1f, 1.0f, 0.1f }, 1.0f));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("RELEASE", "Release", juce::NormalisableRange<float> { 0.1f, 3.0f, 0.1f }, 0.4f));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>("ADSRCURVE", "ADSR Curve", juce::StringArray { "Linear", "Exponential" }, 0));
+
+    // A released voice ends once a whole block of its output is under this level
+    params.push_back (std::make_unique<juce::AudioParameterFloat>("TAILTHRESHOLD", "Tail Threshold", juce::NormalisableRange<float> { -120.0f, -60.0f, 0.1f }, -96.0f, "dBFS"));
 
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERADSRDEPTH", "Filter ADSR Depth", juce::NormalisableRange<float> { 0.0f, 10000.0f, 0.1f, 0.3f }, 10000.0f, ""));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERATTACK", "Filter Attack", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.01f }, 0.01f));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERDECAY", "Filter Decay", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.1f }, 0.1f));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERSUSTAIN", "Filter Sustain", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.1f }, 1.0f));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("FILTERRELEASE", "Filter Release", juce::NormalisableRange<float> { 0.0f, 3.0f, 0.1f }, 0.1f));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>("FILTERADSRCURVE", "Filter ADSR Curve", juce::StringArray { "Linear", "Exponential" }, 0));
 
     // Reverb
     params.push_back (std::make_unique<juce::AudioParameterFloat>("REVERBSIZE", "Reverb Size", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.1f }, 0.0f, ""));
@@ -276,118 +462,249 @@ juce::AudioProcessorValueTreeState::ParameterLayout TapSynthAudioProcessor::crea
     params.push_back (std::make_unique<juce::AudioParameterFloat>("REVERBDRY", "Reverb Dry", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.1f }, 1.0f, ""));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("REVERBWET", "Reverb Wet", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.1f }, 0.0f, ""));
     params.push_back (std::make_unique<juce::AudioParameterFloat>("REVERBFREEZE", "Reverb Freeze", juce::NormalisableRange<float> { 0.0f, 1.0f, 0.1f }, 0.0f, ""));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>("REVERBENGINE", "Reverb Engine", juce::StringArray { "Freeverb", "FDN", "Convolution" }, 0));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>("REVERBQUALITY", "Reverb Quality", juce::StringArray { "Eco", "Standard", "High", "Ultra" }, 1));
 
     return { params.begin(), params.end() };
 }
 
+void TapSynthAudioProcessor::loadTuning (const juce::File& file)
+{
+    if (file.hasFileExtension ("kbm"))
+        tuning.loadKeyboardMapping (file);
+    else
+        tuning.loadScale (file);
+}
+
+void TapSynthAudioProcessor::storeSpectrum (const int slot)
+{
+    std::array<float, HarmonicData::numPartials> decibels;
+
+    for (size_t i = 0; i < decibels.size(); ++i)
+        decibels[i] = partialGainParams[i]->load();
+
+    spectralMorph.setSnapshot (slot, decibels.data());
+}
+
+void TapSynthAudioProcessor::updateModulation (const int startSample, const int numSamples)
+{
+    for (int r = 0; r < ModMatrixData::maxRoutes; ++r)
+        modMatrix.setRoute (r, (int) modSourceParams[(size_t) r]->load(), (int) modDestinationParams[(size_t) r]->load(), modDepthParams[(size_t) r]->load());
+
+    for (int n = 0; n < LfoData::numLfos; ++n)
+    {
+        const auto& p = lfoParams[(size_t) n];
+        lfos.setParams (n, (int) p.shape->load(), p.frequency->load(), p.sync->load() > 0.5f, (int) p.division->load(), (int) p.mode->load());
+    }
+
+    // Where the host would be at the start of this control block
+    controlPosition = playPosition;
+    controlPosition.ppqPosition += startSample / getSampleRate() * playPosition.bpm / 60.0;
+
+    lfos.advance (numSamples, controlPosition);
+
+    // The LFOs have the same columns as the matrix
+    static_assert (LfoData::numColumns == ModMatrixData::numColumns, "One LFO column per matrix column");
+
+    for (int column = 0; column < ModMatrixData::numColumns; ++column)
+    {
+        modMatrix.setSource (ModMatrixData::lfo1, column, lfos.getValue (0, column));
+        modMatrix.setSource (ModMatrixData::lfo2, column, lfos.getValue (1, column));
+    }
+
+    // The envelopes are where the previous block left them
+    const auto setVoiceSources = [&] (const int column, SynthVoice& voice)
+    {
+        const auto i = voice.getVoiceIndex();
+        modMatrix.setSource (ModMatrixData::ampEnvelope, column, voice.getAdsr().getLevel());
+        modMatrix.setSource (ModMatrixData::filterEnvelope, column, voice.getFilterAdsrOutput());
+        modMatrix.setSource (ModMatrixData::velocity, column, voice.getVelocity());
+        modMatrix.setSource (ModMatrixData::key, column, (float) (voice.getNoteNumber() - 60) / 12.0f);
+        modMatrix.setSource (ModMatrixData::pressure, column, expression.getPressure (i));
+        modMatrix.setSource (ModMatrixData::slide, column, expression.getSlide (i));
+    };
+
+    SynthVoice* newestVoice = nullptr;
+
+    synth.forEachVoice (voicesToUpdate, [&] (int i, SynthVoice& voice)
+    {
+        setVoiceSources (i, voice);
+
+        if (voice.isVoiceActive() && (newestVoice == nullptr || newestVoice->wasStartedBefore (voice)))
+            newestVoice = &voice;
+    });
+
+    // The global column follows the most recently started note still playing
+    if (newestVoice != nullptr)
+        setVoiceSources (ModMatrixData::globalColumn, *newestVoice);
+
+    modMatrix.process();
+}
+
 void TapSynthAudioProcessor::setParams()
 {
+    setOversampling ((int) apvts.getRawParameterValue ("OVERSAMPLING")->load());
     setVoiceParams();
-    setFilterParams();
     setReverbParams();
 }
 
+void TapSynthAudioProcessor::setOversampling (const int order)
+{
+    // Under load the voices drop a factor and delay their output by the latency that saves.
+    // The latency stays that of the factor chosen, so it never moves with the load.
+    const auto voiceOrder = governor.limitOversampling (order);
+
+    synth.forEachVoice ([&] (int, SynthVoice& voice) { voice.setOversampling (voiceOrder, order); });
+}
+
+void TapSynthAudioProcessor::parameterChanged (const juce::String& parameterID, float)
+{
+    // May come from the audio thread, and hosts expect latency changes from the message thread
+    if (parameterID == "OVERSAMPLING")
+        triggerAsyncUpdate();
+}
+
+void TapSynthAudioProcessor::handleAsyncUpdate()
+{
+    updateLatency();
+}
+
+void TapSynthAudioProcessor::updateLatency()
+{
+    // Notes already playing keep their factor, so the host compensates for the new one a little early
+    const auto order = (int) apvts.getRawParameterValue ("OVERSAMPLING")->load();
+    setLatencySamples (synth.getSynthVoice (0).getLatencySamples (order));
+}
+
 void TapSynthAudioProcessor::setVoiceParams()
 {
-    for (int i = 0; i < synth.getNumVoices(); ++i)
+    auto& attack = *apvts.getRawParameterValue ("ATTACK");
+    auto& decay = *apvts.getRawParameterValue ("DECAY");
+    auto& sustain = *apvts.getRawParameterValue ("SUSTAIN");
+    auto& release = *apvts.getRawParameterValue ("RELEASE");
+    auto& adsrCurve = *apvts.getRawParameterValue ("ADSRCURVE");
+
+    auto& osc1Choice = *apvts.getRawParameterValue ("OSC1");
+    auto& osc1Mode = *apvts.getRawParameterValue ("OSC1MODE");
+    auto& osc1Pitch = *apvts.getRawParameterValue ("OSC1PITCH");
+    auto& osc1FmRatio = *apvts.getRawParameterValue ("OSC1FMRATIO");
+    auto& osc1FmDepth = *apvts.getRawParameterValue ("OSC1FMDEPTH");
+    auto& partialSeries = *apvts.getRawParameterValue ("PARTIALSERIES");
+    auto& partialStretch = *apvts.getRawParameterValue ("PARTIALSTRETCH");
+    auto& keyTilt = *apvts.getRawParameterValue ("KEYTILT");
+    auto& velocityTilt = *apvts.getRawParameterValue ("VELOCITYTILT");
+    auto& morphOn = *apvts.getRawParameterValue ("MORPHON");
+    auto& morphPosition = *apvts.getRawParameterValue ("MORPH");
+    auto& partialEnvOn = *apvts.getRawParameterValue ("PARTIALENV");
+    auto& partialAttack = *apvts.getRawParameterValue ("PARTIALATTACK");
+    auto& partialDecay = *apvts.getRawParameterValue ("PARTIALDECAY");
+    auto& partialSustain = *apvts.getRawParameterValue ("PARTIALSUSTAIN");
+    auto& partialRelease = *apvts.getRawParameterValue ("PARTIALRELEASE");
+    auto& partialEnvScale = *apvts.getRawParameterValue ("PARTIALENVSCALE");
+    auto& unisonVoices = *apvts.getRawParameterValue ("UNISON");
+    auto& unisonDetune = *apvts.getRawParameterValue ("UNISONDETUNE");
+    auto& unisonSpread = *apvts.getRawParameterValue ("UNISONSPREAD");
+    auto& tailThreshold = *apvts.getRawParameterValue ("TAILTHRESHOLD");
+
+    auto& filterAttack = *apvts.getRawParameterValue ("FILTERATTACK");
+    auto& filterDecay = *apvts.getRawParameterValue ("FILTERDECAY");
+    auto& filterSustain = *apvts.getRawParameterValue ("FILTERSUSTAIN");
+    auto& filterRelease = *apvts.getRawParameterValue ("FILTERRELEASE");
+    auto& filterAdsrCurve = *apvts.getRawParameterValue ("FILTERADSRCURVE");
+
+    // Converted once per block and shared by every voice; -100 dB is silent.
+    // While morphing, the snapshots take the place of the drawbars.
+    isMorphing = morphOn.load() > 0.5f && spectralMorph.process (morphPosition.load(), partialGains.data());
+
+    if (! isMorphing)
     {
-        if (auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-        {
-            auto& attack = *apvts.getRawParameterValue ("ATTACK");
-            auto& decay = *apvts.getRawParameterValue ("DECAY");
-            auto& sustain = *apvts.getRawParameterValue ("SUSTAIN");
-            auto& release = *apvts.getRawParameterValue ("RELEASE");
-
-            auto& osc1Choice = *apvts.getRawParameterValue ("OSC1");
+        for (size_t i = 0; i < partialGains.size(); ++i)
+            partialGains[i] = juce::Decibels::decibelsToGain (partialGainParams[i]->load(), HarmonicData::minGain);
+    }
 
-            auto& osc1Gain = *apvts.getRawParameterValue ("OSC1GAIN");
+    // A changed series is built in the background and picked up by a later block
+    tuning.setParams ((int) partialSeries.load(), partialStretch.load());
+    const auto* incrementTable = tuning.getIncrementTable();
 
-            auto& osc1Pitch = *apvts.getRawParameterValue ("OSC1PITCH");
+    // What the governor leaves of the quality asked for
+    const auto partialFloor = governor.getPartialFloor();
+    const auto releaseFloor = governor.getReleaseFloor();
+    const auto numUnisonVoices = governor.limitUnison ((int) unisonVoices.load());
+    const auto silenceThreshold = juce::Decibels::decibelsToGain (tailThreshold.load(), -200.0f);
 
-            auto& osc1FmFreq = *apvts.getRawParameterValue ("OSC1FMFREQ");
+    synth.forEachVoice (voicesToUpdate, [&] (int i, SynthVoice& voice)
+    {
+        voice.setIncrementTable (incrementTable);
+        voice.setFmParams (osc1FmRatio.load(), osc1FmDepth.load());
+        voice.setTiltTracking (keyTilt.load(), velocityTilt.load());
 
-            auto& osc1FmDepth = *apvts.getRawParameterValue ("OSC1FMDEPTH");
-
-
-            auto& sub1Gain = *apvts.getRawParameterValue("SUB1GAIN");
-            auto& sub2Gain = *apvts.getRawParameterValue("SUB2GAIN");
-            auto& sub3Gain = *apvts.getRawParameterValue("SUB3GAIN");
-            auto& sub4Gain = *apvts.getRawParameterValue("SUB4GAIN");
-            auto& sub5Gain = *apvts.getRawParameterValue("SUB5GAIN");
-            auto& sub6Gain = *apvts.getRawParameterValue("SUB6GAIN");
-            auto& sub7Gain = *apvts.getRawParameterValue("SUB7GAIN");
-            auto& sub8Gain = *apvts.getRawParameterValue("SUB8GAIN");
-            auto& sub9Gain = *apvts.getRawParameterValue("SUB9GAIN");
-            auto& ov1Gain = *apvts.getRawParameterValue("OV1GAIN");
-            auto& ov2Gain = *apvts.getRawParameterValue("OV2GAIN");
-            auto& ov3Gain = *apvts.getRawParameterValue("OV3GAIN");
-            auto& ov4Gain = *apvts.getRawParameterValue("OV4GAIN");
-            auto& ov5Gain = *apvts.getRawParameterValue("OV5GAIN");
-            auto& ov6Gain = *apvts.getRawParameterValue("OV6GAIN");
-            auto& ov7Gain = *apvts.getRawParameterValue("OV7GAIN");
-            auto& ov8Gain = *apvts.getRawParameterValue("OV8GAIN");
-            auto& ov9Gain = *apvts.getRawParameterValue("OV9GAIN");
-
-            auto& filterAttack = *apvts.getRawParameterValue ("FILTERATTACK");
-            auto& filterDecay = *apvts.getRawParameterValue ("FILTERDECAY");
-            auto& filterSustain = *apvts.getRawParameterValue ("FILTERSUSTAIN");
-            auto& filterRelease = *apvts.getRawParameterValue ("FILTERRELEASE");
-
-            auto& osc1 = voice->getOscillator1();
-            auto& sub1 = voice->getSub1();
-            auto& sub2 = voice->getSub2();
-            auto& sub3 = voice->getSub3();
-            auto& sub4 = voice->getSub4();
-            auto& sub5 = voice->getSub5();
-            auto& sub6 = voice->getSub6();
-            auto& sub7 = voice->getSub7();
-            auto& sub8 = voice->getSub8();
-            auto& sub9 = voice->getSub9();
-            auto& ov1  = voice->getOv1();
-            auto& ov2  = voice->getOv2();
-            auto& ov3  = voice->getOv3();
-            auto& ov4  = voice->getOv4();
-            auto& ov5  = voice->getOv5();
-            auto& ov6  = voice->getOv6();
-            auto& ov7  = voice->getOv7();
-            auto& ov8  = voice->getOv8();
-            auto& ov9  = voice->getOv9();
-
-
-            auto& adsr = voice->getAdsr();
-            auto& filterAdsr = voice->getFilterAdsr();
-
-            for (int i = 0; i < getTotalNumOutputChannels(); i++)
+        // The gains follow the matrix, so they are set once per control block in setVoiceModulation()
+        auto setOscParams = [&] (auto& oscillators)
+        {
+            for (int ch = 0; ch < (int) oscillators.size(); ++ch)
             {
-                osc1[i].setParams (osc1Choice, osc1Gain, 0, 0, 0);
-                sub1[i].setParams (osc1Choice, sub1Gain, 0, 0, 0);
-                sub2[i].setParams (osc1Choice, sub2Gain, 0, 0, 0);
-                sub3[i].setParams (osc1Choice, sub3Gain, 0, 0, 0);
-                sub4[i].setParams (osc1Choice, sub4Gain, 0, 0, 0);
-                sub5[i].setParams (osc1Choice, sub5Gain, 0, 0, 0);
-                sub6[i].setParams (osc1Choice, sub6Gain, 0, 0, 0);
-                sub7[i].setParams (osc1Choice, sub7Gain, 0, 0, 0);
-                sub8[i].setParams (osc1Choice, sub8Gain, 0, 0, 0);
-                sub9[i].setParams (osc1Choice, sub9Gain, 0, 0, 0);
-                ov1[i].setParams  (osc1Choice, ov1Gain, 0, 0, 0 );
-                ov2[i].setParams  (osc1Choice, ov2Gain, 0, 0, 0 );
-                ov3[i].setParams  (osc1Choice, ov3Gain, 0, 0, 0 );
-                ov4[i].setParams  (osc1Choice, ov4Gain, 0, 0, 0 );
-                ov5[i].setParams  (osc1Choice, ov5Gain, 0, 0, 0 );
-                ov6[i].setParams  (osc1Choice, ov6Gain, 0, 0, 0 );
-                ov7[i].setParams  (osc1Choice, ov7Gain, 0, 0, 0 );
-                ov8[i].setParams  (osc1Choice, ov8Gain, 0, 0, 0 );
-                ov9[i].setParams  (osc1Choice, ov9Gain, 0, 0, 0 );
-
-
+                auto& osc = oscillators[(size_t) ch];
+                osc.setUnison (numUnisonVoices, unisonDetune.load(), unisonSpread.load() / 100.0f, ch);
+                osc.setPartialFloor (partialFloor);
+                osc.setType (osc1Choice);
+                osc.setRenderMode (osc1Mode);
+                osc.setOscPitch (osc1Pitch);
+            }
+        };
+
+        // Only the oscillators that render at the host's precision
+        if (isUsingDoublePrecision())
+            setOscParams (voice.getOscillator<double>());
+        else
+            setOscParams (voice.getOscillator<float>());
+
+        auto& adsr = voice.getAdsr();
+        auto& filterAdsr = voice.getFilterAdsr();
+
+        adsr.update (attack.load(), decay.load(), sustain.load(), release.load(), (int) adsrCurve.load());
+        filterAdsr.update (filterAttack, filterDecay, filterSustain, filterRelease, (int) filterAdsrCurve.load());
+        voice.getPartialEnvelope().setParams (partialEnvOn.load() > 0.5f, partialAttack.load(), partialDecay.load(), partialSustain.load(), partialRelease.load(), partialEnvScale.load());
+        voice.endReleaseBelow (releaseFloor);
+        voice.setSilenceThreshold (silenceThreshold);
+        voice.endReleaseIfSilent();
+    });
+}
+
+void TapSynthAudioProcessor::setVoiceModulation()
+{
+    auto& pressureTilt = *apvts.getRawParameterValue ("PRESSURETILT");
+    auto& morphPosition = *apvts.getRawParameterValue ("MORPH");
+
+    synth.forEachVoice (voicesToUpdate, [&] (int i, SynthVoice& voice)
+    {
+        const auto tilt = pressureTilt.load() * expression.getPressure (i) + modMatrix.getDestination (ModMatrixData::tilt, i);
+        const auto subharmonicLevel = modMatrix.getDestination (ModMatrixData::subharmonicLevel, i);
+        const auto overtoneLevel = modMatrix.getDestination (ModMatrixData::overtoneLevel, i);
+        voice.setPitchModulation (modMatrix.getDestination (ModMatrixData::pitch, i));
+
+        // A voice whose morph is modulated takes the snapshots at its own position
+        const auto* gains = partialGains.data();
+        const auto morphModulation = modMatrix.getDestination (ModMatrixData::morph, i);
 
+        if (isMorphing && morphModulation != 0.0f && spectralMorph.process (morphPosition.load() + morphModulation, voiceGains.data()))
+            gains = voiceGains.data();
 
+        // The banks ramp to the new gains over the control block
+        auto setOscGains = [&] (auto& oscillators)
+        {
+            for (auto& osc : oscillators)
+            {
+                osc.setTilt (tilt);
+                osc.setSideLevels (subharmonicLevel, overtoneLevel);
+                osc.setGains (gains);
             }
+        };
 
-            adsr.update (attack.load(), decay.load(), sustain.load(), release.load());
-            filterAdsr.update (filterAttack, filterDecay, filterSustain, filterRelease);
-        }
-    }
+        if (isUsingDoublePrecision())
+            setOscGains (voice.getOscillator<double>());
+        else
+            setOscGains (voice.getOscillator<float>());
+    });
 }
 
 void TapSynthAudioProcessor::setFilterParams()
@@ -396,16 +713,14 @@ void TapSynthAudioProcessor::setFilterParams()
     auto& filterCutoff = *apvts.getRawParameterValue ("FILTERCUTOFF");
     auto& filterResonance = *apvts.getRawParameterValue ("FILTERRESONANCE");
     auto& adsrDepth = *apvts.getRawParameterValue ("FILTERADSRDEPTH");
-    auto& lfoFreq = *apvts.getRawParameterValue ("LFO1FREQ");
     auto& lfoDepth = *apvts.getRawParameterValue ("LFO1DEPTH");
+    auto& slideCutoff = *apvts.getRawParameterValue ("SLIDECUTOFF");
 
-    for (int i = 0; i < synth.getNumVoices(); ++i)
+    synth.forEachVoice (voicesToUpdate, [&] (int i, SynthVoice& voice)
     {
-        if (auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-        {
-            voice->updateModParams (filterType, filterCutoff, filterResonance, adsrDepth, lfoFreq, lfoDepth);
-        }
-    }
+        voice.updateModParams (filterType, filterCutoff, filterResonance, adsrDepth, lfoDepth * lfos.getValue (0, i), slideCutoff,
+                               modMatrix.getDestination (ModMatrixData::cutoff, i), modMatrix.getDestination (ModMatrixData::resonance, i));
+    });
 }
 
 void TapSynthAudioProcessor::setReverbParams()
@@ -414,8 +729,14 @@ void TapSynthAudioProcessor::setReverbParams()
     reverbParams.width = *apvts.getRawParameterValue ("REVERBWIDTH");
     reverbParams.damping = *apvts.getRawParameterValue ("REVERBDAMPING");
     reverbParams.dryLevel = *apvts.getRawParameterValue ("REVERBDRY");
-    reverbParams.wetLevel = *apvts.getRawParameterValue ("REVERBWET");
+    reverbParams.wetLevel = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue ("REVERBWET")->load() + modMatrix.getDestination (ModMatrixData::reverbWet, ModMatrixData::globalColumn));
     reverbParams.freezeMode = *apvts.getRawParameterValue ("REVERBFREEZE");
 
     reverb.setParameters (reverbParams);
+
+    fdnReverb.setParams (reverbParams.roomSize, reverbParams.damping, reverbParams.width,
+                         reverbParams.dryLevel, reverbParams.wetLevel, reverbParams.freezeMode,
+                         (int) *apvts.getRawParameterValue ("REVERBQUALITY"));
+
+    convolution.setParams (reverbParams.dryLevel, reverbParams.wetLevel);
 }
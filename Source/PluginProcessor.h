@@ -11,12 +11,24 @@
 #include <JuceHeader.h>
 #include "SynthVoice.h"
 #include "SynthSound.h"
+#include "VoiceManager.h"
 #include "Data/MeterData.h"
+#include "Data/FdnReverbData.h"
+#include "Data/ConvolutionData.h"
+#include "Data/AnalyzerData.h"
+#include "Data/TuningData.h"
+#include "Data/ExpressionData.h"
+#include "Data/SpectralMorphData.h"
+#include "Data/ModMatrixData.h"
+#include "Data/LfoData.h"
+#include "Data/GovernorData.h"
 
 //==============================================================================
 /**
 */
-class TapSynthAudioProcessor  : public juce::AudioProcessor
+class TapSynthAudioProcessor  : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -32,6 +44,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -56,24 +70,94 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    const std::atomic<float>& getRMS() { return meter.getRMS(); }
-    const std::atomic<float>& getPeak() { return meter.getPeak(); }
+    const MeterData::Snapshot& getMeterSnapshot() { return meter.readSnapshot(); }
+    AnalyzerData& getAnalyzer() { return analyzer; }
+    void loadImpulseResponse (const juce::File& file) { convolution.loadImpulseResponse (file); }
+    void loadPartialRatios (const juce::File& file) { tuning.loadUserRatios (file); }
+    void loadTuning (const juce::File& file);
+    float getPartialRatio (const int index) const { return tuning.getRatio (index); }
+
+    // Indexes GovernorData::getQualityNames(); drops while the synth runs over its budget
+    int getQuality() const { return governor.getQuality(); }
+    float getLoad() const { return governor.getLoad(); }
+
+    // Message thread. Stores the current drawbars as one of the morph snapshots.
+    void storeSpectrum (const int slot);
     juce::AudioProcessorValueTreeState apvts;
 
 private:
     static constexpr int numChannelsToProcess { 2 };
-    juce::Synthesiser synth;
+
+    // Declared before the synth, whose voices and sound refer to them
+    ExpressionData expression;
+    LfoData lfos;
+    VoiceManager synth;
+
+    // The voices playing, and those that notes in this block will start
+    juce::uint32 voicesToUpdate { 0 };
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParams();
+
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+    void processEffects (juce::AudioBuffer<float>& buffer);
+
+    void updateModulation (const int startSample, const int numSamples);
     void setParams();
+    void setOversampling (const int order);
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+    void handleAsyncUpdate() override;
+    void updateLatency();
     void setVoiceParams();
+    void setVoiceModulation();
     void setFilterParams();
     void setReverbParams();
 
     static constexpr int numVoices { 5 };
+
+    // The LFOs and matrix run once per this many samples, whatever the buffer size.
+    // Every host block starts a control block, so notes starting in it are set up first.
+    static constexpr int controlBlockSize { PartialEnvelopeData::controlBlockSize };
+
+    GovernorData governor;
+    static_assert (numVoices <= ExpressionData::maxVoices, "Every voice needs a slot in the expression arrays");
+    std::array<std::atomic<float>*, HarmonicData::numPartials> partialGainParams {};
+    std::array<float, HarmonicData::numPartials> partialGains {};
+    SpectralMorphData spectralMorph;
+    bool isMorphing { false };
+
+    // Gains of a voice whose morph position is modulated away from the shared one
+    std::array<float, HarmonicData::numPartials> voiceGains {};
+
+    ModMatrixData modMatrix;
+    std::array<std::atomic<float>*, ModMatrixData::maxRoutes> modSourceParams {};
+    std::array<std::atomic<float>*, ModMatrixData::maxRoutes> modDestinationParams {};
+    std::array<std::atomic<float>*, ModMatrixData::maxRoutes> modDepthParams {};
+
+    struct LfoParams
+    {
+        std::atomic<float>* frequency { nullptr };
+        std::atomic<float>* shape { nullptr };
+        std::atomic<float>* sync { nullptr };
+        std::atomic<float>* division { nullptr };
+        std::atomic<float>* mode { nullptr };
+    };
+
+    std::array<LfoParams, LfoData::numLfos> lfoParams;
+
+    // Read from the host once per block, for tempo sync, and moved on for each control block in it
+    juce::AudioPlayHead::CurrentPositionInfo playPosition;
+    juce::AudioPlayHead::CurrentPositionInfo controlPosition;
     juce::dsp::Reverb reverb;
     juce::Reverb::Parameters reverbParams;
+    FdnReverbData fdnReverb;
+    ConvolutionData convolution;
+
+    // The effects only run in single precision; a double block passes through this
+    juce::AudioBuffer<float> effectsBuffer;
     MeterData meter;
+    AnalyzerData analyzer;
+    TuningData tuning;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TapSynthAudioProcessor)
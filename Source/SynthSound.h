@@ -11,11 +11,18 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Data/ExpressionData.h"
 
 class SynthSound : public juce::SynthesiserSound
 {
 public:
+    SynthSound (const ExpressionData& expressionToUse) : expression (expressionToUse) {}
+
     bool appliesToNote (int midiNoteNumber) override { return true; }
-    bool appliesToChannel (int midiChannel) override { return true; }
-    
+
+    // Every channel, or only the channels of the MPE zones when MPE is on
+    bool appliesToChannel (int midiChannel) override { return expression.appliesToChannel (midiChannel); }
+
+private:
+    const ExpressionData& expression;
 };
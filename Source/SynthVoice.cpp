@@ -10,6 +10,14 @@
 
 #include "SynthVoice.h"
 
+SynthVoice::SynthVoice (ExpressionData& expressionToUse, LfoData& lfosToUse, const int index)
+: expression (expressionToUse)
+, lfos (lfosToUse)
+, voiceIndex (index)
+{
+    jassert (juce::isPositiveAndBelow (voiceIndex, ExpressionData::maxVoices));
+}
+
 bool SynthVoice::canPlaySound (juce::SynthesiserSound* sound)
 {
     return dynamic_cast<juce::SynthesiserSound*>(sound) != nullptr;
@@ -17,60 +25,131 @@ bool SynthVoice::canPlaySound (juce::SynthesiserSound* sound)
 
 void SynthVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition)
 {
-    for (int i = 0; i < 2; i++)
-    {
-        osc1[i].setFreq (midiNoteNumber);
-        sub1[i].setSubFreq(midiNoteNumber, 2);
-        sub2[i].setSubFreq(midiNoteNumber, 3);
-        sub3[i].setSubFreq(midiNoteNumber, 4);
-        sub4[i].setSubFreq(midiNoteNumber, 5);
-        sub5[i].setSubFreq(midiNoteNumber, 6);
-        sub6[i].setSubFreq(midiNoteNumber, 7);
-        sub7[i].setSubFreq(midiNoteNumber, 8);
-        sub8[i].setSubFreq(midiNoteNumber, 9);
-        sub9[i].setSubFreq(midiNoteNumber, 10);
-        ov1[i].setHarmonicFreq(midiNoteNumber, 2);
-        ov2[i].setHarmonicFreq(midiNoteNumber, 3);
-        ov3[i].setHarmonicFreq(midiNoteNumber, 4);
-        ov4[i].setHarmonicFreq(midiNoteNumber, 5);
-        ov5[i].setHarmonicFreq(midiNoteNumber, 6);
-        ov6[i].setHarmonicFreq(midiNoteNumber, 7);
-        ov7[i].setHarmonicFreq(midiNoteNumber, 8);
-        ov8[i].setHarmonicFreq(midiNoteNumber, 9);
-        ov9[i].setHarmonicFreq(midiNoteNumber, 10);
-
-        //osc2[i].setFreq (midiNoteNumber);
-    }
+    for (int channel = 1; channel <= 16; ++channel)
+        if (isPlayingChannel (channel))
+            midiChannel = channel;
+
+    expression.startVoice (voiceIndex, midiChannel);
+
+    noteNumber = midiNoteNumber;
+    noteVelocity = velocity;
+
+    notePitchBend = 0.0f;
+    pitchWheelMoved (currentPitchWheelPosition);
+    updatePitchBend();
+
+    // Before the increments, which are scaled to the oversampled rate
+    if (pendingOversamplingOrder != oversamplingOrder || pendingReportedOrder != reportedOrder)
+        applyOversampling();
+
+    // Copied so a table swapped in while the note plays cannot change its tuning
+    if (incrementTable != nullptr)
+        forEachOscillator ([this, midiNoteNumber] (auto& o) { o.setIncrements (incrementTable->increment[(size_t) midiNoteNumber].data()); });
+
+    // Fixed for the length of the note; soft notes tilt away from full velocity
+    const auto noteTilt = keyTracking * (float) (midiNoteNumber - 60) / 12.0f + velocityTracking * (velocity - 1.0f);
+    forEachOscillator ([noteTilt] (auto& o) { o.setNoteTilt (noteTilt); });
+
+    // The modulator starts in step with the note, so attacks sound the same every time
+    floatProcessors.fmPhase = 0;
+    doubleProcessors.fmPhase = 0;
+
+    blockPeak = 0.0f;
+
+    if (activeVoices != nullptr)
+        *activeVoices |= 1u << voiceIndex;
 
+    lfos.noteOn (voiceIndex);
     adsr.noteOn();
     filterAdsr.noteOn();
+    partialEnvelope.noteOn();
 }
 
 void SynthVoice::stopNote (float velocity, bool allowTailOff)
 {
     adsr.noteOff();
     filterAdsr.noteOff();
+    partialEnvelope.noteOff();
 
     if (! allowTailOff || ! adsr.isActive())
-        clearCurrentNote();
+        endNote();
 }
 
-void SynthVoice::controllerMoved (int controllerNumber, int newControllerValue)
+void SynthVoice::endNote()
+{
+    if (activeVoices != nullptr)
+        *activeVoices &= ~(1u << voiceIndex);
+
+    clearCurrentNote();
+}
+
+void SynthVoice::endReleaseBelow (const float level)
+{
+    if (isPlayingButReleased() && adsr.getLevel() < level)
+    {
+        adsr.reset();
+        endNote();
+    }
+}
+
+void SynthVoice::endReleaseIfSilent()
 {
+    // A long release can stay inaudible well before the envelope reaches zero
+    if (isPlayingButReleased() && blockPeak < silenceThreshold)
+    {
+        adsr.reset();
+        endNote();
+    }
 
+    blockPeak = 0.0f;
+}
+
+void SynthVoice::controllerMoved (int controllerNumber, int newControllerValue)
+{
+    if (controllerNumber == ExpressionData::slideController)
+        expression.setSlide (voiceIndex, (float) (newControllerValue - 64) / 64.0f);
 }
 
 void SynthVoice::pitchWheelMoved (int newPitchWheelValue)
 {
+    // The master channel's bend reaches every note through updatePitchBend()
+    if (expression.isMasterChannel (midiChannel))
+        return;
+
+    notePitchBend = expression.getPitchBendRange (midiChannel) * (float) (newPitchWheelValue - 8192) / 8192.0f;
+    updatePitchBend();
+}
+
+void SynthVoice::channelPressureChanged (int newChannelPressureValue)
+{
+    expression.setPressure (voiceIndex, (float) newChannelPressureValue / 127.0f);
+}
 
+void SynthVoice::aftertouchChanged (int newAftertouchValue)
+{
+    expression.setPressure (voiceIndex, (float) newAftertouchValue / 127.0f);
+}
+
+void SynthVoice::updatePitchBend()
+{
+    // Only sets a target; the oscillators glide to it at control rate
+    const auto semitones = notePitchBend + expression.getMasterPitchBend (midiChannel) + pitchModulation;
+    forEachOscillator ([semitones] (auto& o) { o.setPitchBend (semitones); });
 }
 
 void SynthVoice::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
 {
     reset();
 
-    adsr.setSampleRate (sampleRate);
-    filterAdsr.setSampleRate (sampleRate);
+    maxBlockSize = samplesPerBlock;
+    numOutputChannels = outputChannels;
+
+    // Whatever runs at the oversampled rate is sized for the highest factor
+    const auto maxOversampledBlock = samplesPerBlock << maxOversamplingOrder;
+
+    adsr.prepareToPlay (sampleRate, samplesPerBlock);
+    filterAdsr.prepareToPlay (sampleRate, samplesPerBlock);
+    partialEnvelope.prepareToPlay (sampleRate, maxOversampledBlock);
 
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
@@ -79,131 +158,271 @@ void SynthVoice::prepareToPlay (double sampleRate, int samplesPerBlock, int outp
 
     for (int ch = 0; ch < numChannelsToProcess; ch++)
     {
-        osc1[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub1[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub2[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub3[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub4[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub5[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub6[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub7[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub8[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        sub9[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov1[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov2[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov3[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov4[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov5[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov6[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov7[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov8[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        ov9[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-
-        //osc2[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        filter[ch].prepareToPlay (sampleRate, samplesPerBlock, outputChannels);
-        lfo[ch].prepare (spec);
-        lfo[ch].initialise ([](float x) { return std::sin (x); });
+        floatProcessors.osc[ch].prepareToPlay (sampleRate, maxOversampledBlock, outputChannels);
+        doubleProcessors.osc[ch].prepareToPlay (sampleRate, maxOversampledBlock, outputChannels);
     }
 
-    gain.prepare (spec);
-    gain.setGainLinear (0.07f);
+    floatProcessors.gain.prepare (spec);
+    floatProcessors.gain.setGainLinear (0.07f);
+    doubleProcessors.gain.prepare (spec);
+    doubleProcessors.gain.setGainLinear (0.07);
 
+    floatProcessors.synthBuffer.setSize (outputChannels, samplesPerBlock);
+    doubleProcessors.synthBuffer.setSize (outputChannels, samplesPerBlock);
+    floatProcessors.phaseModulation.assign ((size_t) maxOversampledBlock, 0.0f);
+    doubleProcessors.phaseModulation.assign ((size_t) maxOversampledBlock, 0.0);
+
+    // Integer latency, so the host can compensate it exactly
+    const auto prepareOversampling = [samplesPerBlock, outputChannels] (auto& oversampling)
+    {
+        using Oversampling = typename std::decay_t<decltype (oversampling)>::value_type::element_type;
+
+        for (size_t i = 0; i < oversampling.size(); ++i)
+        {
+            oversampling[i] = std::make_unique<Oversampling> ((size_t) outputChannels, i + 1, Oversampling::filterHalfBandPolyphaseIIR, true, true);
+            oversampling[i]->initProcessing ((size_t) samplesPerBlock);
+        }
+    };
+
+    prepareOversampling (floatProcessors.oversampling);
+    prepareOversampling (doubleProcessors.oversampling);
     isPrepared = true;
+
+    // Room for the whole latency of the highest factor
+    const auto maxPadding = getLatencySamples (maxOversamplingOrder);
+    floatProcessors.latencyPadding.prepare (spec);
+    floatProcessors.latencyPadding.setMaximumDelayInSamples (juce::jmax (1, maxPadding));
+    doubleProcessors.latencyPadding.prepare (spec);
+    doubleProcessors.latencyPadding.setMaximumDelayInSamples (juce::jmax (1, maxPadding));
+
+    applyOversampling();
+}
+
+void SynthVoice::applyOversampling()
+{
+    oversamplingOrder = pendingOversamplingOrder;
+
+    const auto factor = 1 << oversamplingOrder;
+    const auto oversampledRate = getSampleRate() * factor;
+
+    forEachOscillator ([factor] (auto& o) { o.setOversamplingFactor (factor); });
+    partialEnvelope.setSampleRate (oversampledRate);
+
+    // Each control block's cutoff and resonance are reached by the start of the next
+    smoothedCutoff.reset (PartialEnvelopeData::controlBlockSize * factor);
+    smoothedResonance.reset (PartialEnvelopeData::controlBlockSize * factor);
+
+    for (int ch = 0; ch < numChannelsToProcess; ++ch)
+    {
+        floatProcessors.filter[ch].prepareToPlay (oversampledRate, maxBlockSize * factor, numOutputChannels);
+        doubleProcessors.filter[ch].prepareToPlay (oversampledRate, maxBlockSize * factor, numOutputChannels);
+    }
+
+    // The decimator may still hold the tail of the last note played at this factor
+    if (oversamplingOrder > 0)
+    {
+        floatProcessors.oversampling[(size_t) oversamplingOrder - 1]->reset();
+        doubleProcessors.oversampling[(size_t) oversamplingOrder - 1]->reset();
+    }
+
+    // A lower factor than the host compensates for would come out early
+    reportedOrder = pendingReportedOrder;
+    paddingSamples = juce::jmax (0, getLatencySamples (reportedOrder) - getLatencySamples (oversamplingOrder));
+
+    floatProcessors.latencyPadding.reset();
+    floatProcessors.latencyPadding.setDelay ((float) paddingSamples);
+    doubleProcessors.latencyPadding.reset();
+    doubleProcessors.latencyPadding.setDelay ((double) paddingSamples);
+}
+
+int SynthVoice::getLatencySamples (const int order) const
+{
+    if (order <= 0 || ! isPrepared)
+        return 0;
+
+    // The same at either precision
+    return juce::roundToInt (floatProcessors.oversampling[(size_t) juce::jmin (order, maxOversamplingOrder) - 1]->getLatencyInSamples());
 }
 
 void SynthVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int startSample, int numSamples)
+{
+    render (outputBuffer, startSample, numSamples);
+}
+
+void SynthVoice::renderNextBlock (juce::AudioBuffer< double > &outputBuffer, int startSample, int numSamples)
+{
+    render (outputBuffer, startSample, numSamples);
+}
+
+template <typename SampleType>
+void SynthVoice::render (juce::AudioBuffer<SampleType>& outputBuffer, int startSample, int numSamples)
 {
     jassert (isPrepared);
 
+    auto& processors = getProcessors<SampleType>();
+    auto& osc = processors.osc;
+    auto& filter = processors.filter;
+    auto& gain = processors.gain;
+    auto& synthBuffer = processors.synthBuffer;
+
     if (! isVoiceActive())
         return;
 
+    updatePitchBend();
+
     synthBuffer.setSize (outputBuffer.getNumChannels(), numSamples, false, false, true);
 
-    filterAdsr.applyEnvelopeToBuffer (synthBuffer, 0, synthBuffer.getNumSamples());
-    filterAdsrOutput = filterAdsr.getNextSample();
+    // The filter follows its envelope once per block
+    filterAdsrOutput = filterAdsr.skip (synthBuffer.getNumSamples());
 
     synthBuffer.clear();
 
-    for (int ch = 0; ch < synthBuffer.getNumChannels(); ++ch)
+    // The oscillators and filter render straight into the oversampled buffer,
+    // once for the whole voice. The up stage is only there to hand that buffer over.
+    juce::dsp::AudioBlock<SampleType> audioBlock { synthBuffer };
+    auto* oversampler = oversamplingOrder > 0 ? processors.oversampling[(size_t) oversamplingOrder - 1].get() : nullptr;
+    auto renderBlock = oversampler != nullptr ? oversampler->processSamplesUp (audioBlock) : audioBlock;
+    const auto numToRender = (int) renderBlock.getNumSamples();
+    const auto numChannels = (int) renderBlock.getNumChannels();
+
+    if (oversampler != nullptr)
+        renderBlock.clear();
+
+    const auto* phaseModulation = renderFmModulator (processors, numToRender);
+    const auto* envelopeLevels = partialEnvelope.process (numToRender);
+
+    if (osc[0].isUnisonOn())
     {
-        auto* buffer = synthBuffer.getWritePointer (ch, 0);
+        // A mono output gets both sides of the spread in its one channel
+        auto* left = renderBlock.getChannelPointer (0);
+        auto* right = renderBlock.getChannelPointer ((size_t) juce::jmin (1, numChannels - 1));
 
-        for (int s = 0; s < synthBuffer.getNumSamples(); ++s)
+        for (auto& o : osc)
+            o.renderNextBlock (left, right, numToRender, phaseModulation, envelopeLevels);
+
+        for (int ch = 2; ch < numChannels; ++ch)
+            renderBlock.getSingleChannelBlock ((size_t) ch).copyFrom (renderBlock.getSingleChannelBlock (0));
+    }
+    else
+    {
+        osc[0].renderNextBlock (renderBlock.getChannelPointer (0), numToRender, phaseModulation, envelopeLevels);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            renderBlock.getSingleChannelBlock ((size_t) ch).copyFrom (renderBlock.getSingleChannelBlock (0));
+    }
+
+    // Cutoff and resonance move in short steps, as each change recomputes the filter's coefficients
+    const auto filterStep = filterSmoothingStep << oversamplingOrder;
+
+    for (int start = 0; start < numToRender; start += filterStep)
+    {
+        const auto numInStep = juce::jmin (filterStep, numToRender - start);
+        const auto cutoff = smoothedCutoff.skip (numInStep);
+        const auto resonance = smoothedResonance.skip (numInStep);
+
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            buffer[s] = osc1[ch].processNextSample (buffer[s]) +
-                        sub1[ch].processNextSample (buffer[s]) +
-                        sub2[ch].processNextSample (buffer[s]) +
-                        sub3[ch].processNextSample (buffer[s]) +
-                        sub4[ch].processNextSample (buffer[s]) +
-                        sub5[ch].processNextSample (buffer[s]) +
-                        sub6[ch].processNextSample (buffer[s]) +
-                        sub7[ch].processNextSample (buffer[s]) +
-                        sub8[ch].processNextSample (buffer[s]) +
-                        sub9[ch].processNextSample (buffer[s]) +
-                        ov1[ch].processNextSample  (buffer[s]) +
-                        ov2[ch].processNextSample  (buffer[s]) +
-                        ov3[ch].processNextSample  (buffer[s]) +
-                        ov4[ch].processNextSample  (buffer[s]) +
-                        ov5[ch].processNextSample  (buffer[s]) +
-                        ov6[ch].processNextSample  (buffer[s]) +
-                        ov7[ch].processNextSample  (buffer[s]) +
-                        ov8[ch].processNextSample  (buffer[s]) +
-                        ov9[ch].processNextSample  (buffer[s]);
+            auto* samples = renderBlock.getChannelPointer ((size_t) ch) + start;
+            filter[ch].setParams (currentFilterType, cutoff, resonance);
 
+            for (int s = 0; s < numInStep; ++s)
+                samples[s] = filter[ch].processNextSample (ch, samples[s]);
         }
     }
 
-    juce::dsp::AudioBlock<float> audioBlock { synthBuffer };
-    gain.process (juce::dsp::ProcessContextReplacing<float> (audioBlock));
+    if (oversampler != nullptr)
+        oversampler->processSamplesDown (audioBlock);
+
+    // Gain and envelope are linear, so they run after the decimator, at the output rate
+    gain.process (juce::dsp::ProcessContextReplacing<SampleType> (audioBlock));
     adsr.applyEnvelopeToBuffer (synthBuffer, 0, synthBuffer.getNumSamples());
 
-    for (int ch = 0; ch < synthBuffer.getNumChannels(); ++ch)
+    if (paddingSamples > 0)
     {
-        auto* buffer = synthBuffer.getWritePointer (ch, 0);
+        auto& padding = processors.latencyPadding;
 
-        for (int s = 0; s < synthBuffer.getNumSamples(); ++s)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            //lfoOutput[ch] = lfo[ch].processSample (synthBuffer.getSample (ch, s));
-            buffer[s] = filter[ch].processNextSample (ch, synthBuffer.getSample (ch, s));
+            auto* samples = synthBuffer.getWritePointer (ch);
+
+            for (int s = 0; s < numSamples; ++s)
+            {
+                padding.pushSample (ch, samples[s]);
+                samples[s] = padding.popSample (ch);
+            }
         }
     }
 
     for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
-    {
         outputBuffer.addFrom (channel, startSample, synthBuffer, channel, 0, numSamples);
 
-        if (! adsr.isActive())
-            clearCurrentNote();
+    blockPeak = juce::jmax (blockPeak, (float) synthBuffer.getMagnitude (0, numSamples));
+
+    if (! adsr.isActive())
+    {
+        adsr.reset();
+        endNote();
     }
 }
 
+template <typename SampleType>
+const SampleType* SynthVoice::renderFmModulator (Processors<SampleType>& processors, const int numSamples)
+{
+    if (fmDepth <= 0.0f)
+        return nullptr;
+
+    auto& modulation = processors.phaseModulation;
+    jassert (numSamples <= (int) modulation.size());
+
+    // Follows bends and transposition of the fundamental once per block
+    const auto increment = (SampleType) fmRatio * processors.osc[0].getFundamentalIncrement();
+
+    // Peak deviation in cycles. The bank wraps phases by truncation, so the modulation
+    // sits on a fixed offset of two whole cycles, which covers the deepest deviation
+    // (10 rad is under 1.6 cycles) and, being whole, does not move the phase. An offset
+    // that followed the depth would jump the phase whenever the depth changed.
+    const auto deviation = (SampleType) fmDepth / juce::MathConstants<SampleType>::twoPi;
+    auto phase = processors.fmPhase;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        modulation[(size_t) s] = 2 + deviation * std::sin (juce::MathConstants<SampleType>::twoPi * phase);
+        phase += increment;
+        phase -= (SampleType) (int) phase;
+    }
+
+    processors.fmPhase = phase;
+    return modulation.data();
+}
+
 void SynthVoice::reset()
 {
-    gain.reset();
+    floatProcessors.gain.reset();
+    doubleProcessors.gain.reset();
     adsr.reset();
     filterAdsr.reset();
+    partialEnvelope.reset();
 }
 
-void SynthVoice::updateModParams (const int filterType, const float filterCutoff, const float filterResonance, const float adsrDepth, const float lfoFreq, const float lfoDepth)
+void SynthVoice::updateModParams (const int filterType, const float filterCutoff, const float filterResonance, const float adsrDepth, const float lfoCutoff, const float slideDepth, const float cutoffModulation, const float resonanceModulation)
 {
-    auto cutoff = (adsrDepth * filterAdsrOutput) + filterCutoff;
+    auto cutoff = (adsrDepth * filterAdsrOutput) + filterCutoff + lfoCutoff;
+    cutoff *= std::exp2 (slideDepth * expression.getSlide (voiceIndex) + cutoffModulation);
     cutoff = std::clamp<float> (cutoff, 20.0f, 20000.0f);
 
-    for (int ch = 0; ch < numChannelsToProcess; ++ch)
+    const auto resonance = std::clamp<float> (filterResonance + resonanceModulation, 0.1f, 2.0f);
+
+    currentFilterType = filterType;
+
+    // A note about to start on this voice begins at the values, rather than gliding from the last note's
+    if (isVoiceActive())
     {
-        filter[ch].setParams (filterType, cutoff, filterResonance);
+        smoothedCutoff.setTargetValue (cutoff);
+        smoothedResonance.setTargetValue (resonance);
+    }
+    else
+    {
+        smoothedCutoff.setCurrentAndTargetValue (cutoff);
+        smoothedResonance.setCurrentAndTargetValue (resonance);
     }
-
-//    auto cutoff = (adsrDepth * adsr.getNextSample()) + filterCutoff;
-//
-//    DBG (cutoff);
-//
-//    for (int ch = 0; ch < numChannelsToProcess; ++ch)
-//    {
-//        lfo[ch].setFrequency (lfoFreq);
-//        //cutoff = (lfoDepth * lfoOutput[ch]) + cutoff;
-//        cutoff = std::clamp<float> (cutoff, 20.0f, 20000.0f);
-//        filter[ch].setParams (filterType, cutoff, filterResonance);
-//    }
 }
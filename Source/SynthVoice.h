@@ -15,79 +15,187 @@
 #include "Data/OscData.h"
 #include "Data/FilterData.h"
 #include "Data/AdsrData.h"
+#include "Data/TuningData.h"
+#include "Data/ExpressionData.h"
+#include "Data/PartialEnvelopeData.h"
+#include "Data/LfoData.h"
 
 class SynthVoice : public juce::SynthesiserVoice
 {
 public:
+    SynthVoice (ExpressionData& expressionToUse, LfoData& lfosToUse, const int index);
+
     bool canPlaySound (juce::SynthesiserSound* sound) override;
     void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition) override;
     void stopNote (float velocity, bool allowTailOff) override;
     void controllerMoved (int controllerNumber, int newControllerValue) override;
     void pitchWheelMoved (int newPitchWheelValue) override;
+    void channelPressureChanged (int newChannelPressureValue) override;
+    void aftertouchChanged (int newAftertouchValue) override;
     void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
     void renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int startSample, int numSamples) override;
+    void renderNextBlock (juce::AudioBuffer< double > &outputBuffer, int startSample, int numSamples) override;
 
     void reset();
 
-    std::array<OscData, 2>& getOscillator1() { return osc1; }
-    std::array<OscData, 2>& getSub1() { return sub1; }
-    std::array<OscData, 2>& getSub2() { return sub2; }
-    std::array<OscData, 2>& getSub3() { return sub3; }
-    std::array<OscData, 2>& getSub4() { return sub4; }
-    std::array<OscData, 2>& getSub5() { return sub5; }
-    std::array<OscData, 2>& getSub6() { return sub6; }
-    std::array<OscData, 2>& getSub7() { return sub7; }
-    std::array<OscData, 2>& getSub8() { return sub8; }
-    std::array<OscData, 2>& getSub9() { return sub9; }
-    std::array<OscData, 2>& getOv1()  { return ov1; }
-    std::array<OscData, 2>& getOv2()  { return ov2; }
-    std::array<OscData, 2>& getOv3()  { return ov3; }
-    std::array<OscData, 2>& getOv4()  { return ov4; }
-    std::array<OscData, 2>& getOv5()  { return ov5; }
-    std::array<OscData, 2>& getOv6()  { return ov6; }
-    std::array<OscData, 2>& getOv7()  { return ov7; }
-    std::array<OscData, 2>& getOv8()  { return ov8; }
-    std::array<OscData, 2>& getOv9()  { return ov9; }
-
-
+    int getVoiceIndex() const noexcept { return voiceIndex; }
+
+    // The voice keeps bit voiceIndex of mask set while it plays
+    void setActiveVoices (juce::uint32& mask) { activeVoices = &mask; }
+
+    // The oscillators that render at the given precision
+    template <typename SampleType>
+    std::array<OscData<SampleType>, 2>& getOscillator() { return getProcessors<SampleType>().osc; }
+
+    void setIncrementTable (const TuningData::IncrementTable* table) { incrementTable = table; }
+
+    // In dB per octave of tilt: per octave of key from middle C, and at zero velocity
+    void setTiltTracking (const float keyTilt, const float velocityTilt) { keyTracking = keyTilt; velocityTracking = velocityTilt; }
+
+    // ratio is of the fundamental; depth is the peak phase deviation in radians
+    void setFmParams (const float ratio, const float depth) { fmRatio = ratio; fmDepth = depth; }
 
     AdsrData& getAdsr() { return adsr; }
     AdsrData& getFilterAdsr() { return filterAdsr; }
+    PartialEnvelopeData& getPartialEnvelope() { return partialEnvelope; }
     float getFilterAdsrOutput() { return filterAdsrOutput; }
-    void updateModParams (const int filterType, const float filterCutoff, const float filterResonance, const float adsrDepth, const float lfoFreq, const float lfoDepth);
+
+    // Modulation sources of the note that is playing, or last played
+    float getVelocity() const noexcept { return noteVelocity; }
+    int getNoteNumber() const noexcept { return noteNumber; }
+
+    // Once per control block; the filter glides to the new values over the block.
+    // lfoCutoff is in Hz; cutoffModulation is in octaves and resonanceModulation is added to the resonance
+    void updateModParams (const int filterType, const float filterCutoff, const float filterResonance, const float adsrDepth, const float lfoCutoff, const float slideDepth, const float cutoffModulation, const float resonanceModulation);
+
+    // In semitones, on top of the bends
+    void setPitchModulation (const float semitones) { pitchModulation = semitones; }
+
+    // 0 is off, and 1 to maxOversamplingOrder give 2x to 8x. A playing note keeps its factor until the next note.
+    // reportedOrder is the factor whose latency the host compensates; a voice running lower is delayed to match it.
+    void setOversampling (const int order, const int reportedOrder)
+    {
+        pendingOversamplingOrder = juce::jlimit (0, maxOversamplingOrder, order);
+        pendingReportedOrder = juce::jlimit (0, maxOversamplingOrder, reportedOrder);
+    }
+
+    // At the output rate
+    int getLatencySamples (const int order) const;
+
+    // Ends the note if it has been released and its envelope has fallen under level
+    void endReleaseBelow (const float level);
+
+    // A released note ends after a whole host block of output under this gain
+    void setSilenceThreshold (const float gain) { silenceThreshold = gain; }
+
+    // Once per host block, before it renders. The synth splits blocks at MIDI
+    // events, so a single render can be too short to judge the output by.
+    void endReleaseIfSilent();
+
+    static constexpr int maxOversamplingOrder { 3 };
 
 private:
     static constexpr int numChannelsToProcess { 2 };
-    std::array<OscData, numChannelsToProcess> osc1;
-    std::array<OscData, numChannelsToProcess> sub1;
-    std::array<OscData, numChannelsToProcess> sub2;
-    std::array<OscData, numChannelsToProcess> sub3;
-    std::array<OscData, numChannelsToProcess> sub4;
-    std::array<OscData, numChannelsToProcess> sub5;
-    std::array<OscData, numChannelsToProcess> sub6;
-    std::array<OscData, numChannelsToProcess> sub7;
-    std::array<OscData, numChannelsToProcess> sub8;
-    std::array<OscData, numChannelsToProcess> sub9;
-    std::array<OscData, numChannelsToProcess> ov1;
-    std::array<OscData, numChannelsToProcess> ov2;
-    std::array<OscData, numChannelsToProcess> ov3;
-    std::array<OscData, numChannelsToProcess> ov4;
-    std::array<OscData, numChannelsToProcess> ov5;
-    std::array<OscData, numChannelsToProcess> ov6;
-    std::array<OscData, numChannelsToProcess> ov7;
-    std::array<OscData, numChannelsToProcess> ov8;
-    std::array<OscData, numChannelsToProcess> ov9;
-
-
-    std::array<FilterData, numChannelsToProcess> filter;
-    std::array<juce::dsp::Oscillator<float>, numChannelsToProcess> lfo;
+
+    // Everything that runs at sample rate, once per precision. Only the set
+    // matching the host's precision is rendered; note and pitch changes go to both.
+    template <typename SampleType>
+    struct Processors
+    {
+        // Without unison both channels play the same partials, so only osc[0] is
+        // rendered; with it each bank plays its half of the copies
+        std::array<OscData<SampleType>, numChannelsToProcess> osc;
+        std::array<FilterData<SampleType>, numChannelsToProcess> filter;
+        juce::dsp::Gain<SampleType> gain;
+        juce::AudioBuffer<SampleType> synthBuffer;
+
+        // 2x, 4x and 8x, polyphase IIR half-band stages; only the one in use runs
+        std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, maxOversamplingOrder> oversampling;
+
+        // The voice's FM modulator, shared by both banks
+        std::vector<SampleType> phaseModulation;
+        SampleType fmPhase { 0 };
+
+        // Makes up the latency of a lower factor than the one reported
+        juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None> latencyPadding;
+    };
+
+    template <typename SampleType>
+    Processors<SampleType>& getProcessors()
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return floatProcessors;
+        else
+            return doubleProcessors;
+    }
+
+    template <typename Function>
+    void forEachOscillator (Function&& function)
+    {
+        for (auto& o : floatProcessors.osc)
+            function (o);
+
+        for (auto& o : doubleProcessors.osc)
+            function (o);
+    }
+
+    template <typename SampleType>
+    void render (juce::AudioBuffer<SampleType>& outputBuffer, int startSample, int numSamples);
+
+    template <typename SampleType>
+    const SampleType* renderFmModulator (Processors<SampleType>& processors, const int numSamples);
+
+    void updatePitchBend();
+    void applyOversampling();
+
+    // Every note ends here, so the active bit always follows isVoiceActive()
+    void endNote();
+
+    Processors<float> floatProcessors;
+    Processors<double> doubleProcessors;
+    const TuningData::IncrementTable* incrementTable { nullptr };
+
+    // Pressure and slide live in the shared arrays, at voiceIndex
+    ExpressionData& expression;
+
+    // Per-voice LFOs restart when this voice starts a note
+    LfoData& lfos;
+    const int voiceIndex;
+    juce::uint32* activeVoices { nullptr };
+    int midiChannel { 1 };
+    float notePitchBend { 0.0f };
+    float pitchModulation { 0.0f };
+    float noteVelocity { 0.0f };
+    int noteNumber { 60 };
+    float fmRatio { 1.0f };
+    float fmDepth { 0.0f };
+    float keyTracking { 0.0f };
+    float velocityTracking { 0.0f };
     AdsrData adsr;
     AdsrData filterAdsr;
-    juce::AudioBuffer<float> synthBuffer;
+
+    // Shared by both precisions and both banks
+    PartialEnvelopeData partialEnvelope;
     float filterAdsrOutput { 0.0f };
-    std::array<float, numChannelsToProcess> lfoOutput { 0.0f, 0.0f };
+    float silenceThreshold { 0.0f };
+
+    // Set once per control block and smoothed across it, at the rate the filter runs at
+    static constexpr int filterSmoothingStep { 8 };
+    int currentFilterType { 0 };
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> smoothedCutoff { 1000.0f };
+    juce::SmoothedValue<float> smoothedResonance { 1.0f / juce::MathConstants<float>::sqrt2 };
+
+    // Of the output since the last endReleaseIfSilent()
+    float blockPeak { 0.0f };
 
+    // The oscillators, filter and partial envelopes run at the oversampled rate
+    int oversamplingOrder { 0 };
+    int pendingOversamplingOrder { 0 };
+    int reportedOrder { 0 };
+    int pendingReportedOrder { 0 };
+    int paddingSamples { 0 };
+    int maxBlockSize { 0 };
+    int numOutputChannels { 0 };
 
-    juce::dsp::Gain<float> gain;
     bool isPrepared { false };
 };
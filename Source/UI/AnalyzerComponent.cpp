@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    AnalyzerComponent.cpp
+    Created: 19 Oct 2026 3:12:40pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AnalyzerComponent.h"
+
+//==============================================================================
+AnalyzerComponent::AnalyzerComponent (TapSynthAudioProcessor& p) : audioProcessor (p)
+{
+    spectrum.fill (AnalyzerData::minDecibels);
+
+    const auto& partials = HarmonicData::getPartials();
+
+    for (size_t i = 0; i < partials.size(); ++i)
+        partialGains[i] = audioProcessor.apvts.getRawParameterValue (partials[i].paramId);
+
+    setName ("Analyzer");
+    startTimer (analyzerIntervalMs);
+}
+
+AnalyzerComponent::~AnalyzerComponent()
+{
+    // Blocks until a running callback has finished
+    stopTimer();
+}
+
+void AnalyzerComponent::hiResTimerCallback()
+{
+    audioProcessor.getAnalyzer().update();
+}
+
+void AnalyzerComponent::paintOverChildren (juce::Graphics& g)
+{
+    auto& analyzer = audioProcessor.getAnalyzer();
+    analyzer.copySpectrum (spectrum);
+    analyzer.copyScope (scope);
+
+    drawSpectrum (g);
+    drawScope (g);
+}
+
+void AnalyzerComponent::drawSpectrum (juce::Graphics& g)
+{
+    const auto area = spectrumArea.toFloat();
+
+    g.setColour (juce::Colours::white.withAlpha (0.15f));
+
+    for (auto frequency : { 100.0f, 1000.0f, 10000.0f })
+        g.drawVerticalLine (juce::roundToInt (getFrequencyX (frequency)), area.getY(), area.getBottom());
+
+    // Overtones of the last note in the oscillator colour, subharmonics in the filter colour
+    const auto fundamental = audioProcessor.getAnalyzer().getFundamental();
+
+    if (fundamental > 0.0f)
+    {
+        for (int i = 0; i < HarmonicData::numPartials; ++i)
+        {
+            const auto frequency = fundamental * audioProcessor.getPartialRatio (i);
+
+            if (partialGains[(size_t) i]->load() <= HarmonicData::minGain || frequency < minFrequency || frequency > maxFrequency)
+                continue;
+
+            if (HarmonicData::isFundamental (i))
+                g.setColour (juce::Colours::white.withAlpha (0.6f));
+            else if (HarmonicData::isSubharmonic (i))
+                g.setColour (juce::Colour::fromRGB (246, 87, 64).withAlpha (0.4f));
+            else
+                g.setColour (juce::Colour::fromRGB (247, 190, 67).withAlpha (0.4f));
+
+            g.drawVerticalLine (juce::roundToInt (getFrequencyX (frequency)), area.getY(), area.getBottom());
+        }
+    }
+
+    // One point per pixel column, taking the loudest bin that falls inside it
+    const auto binWidth = (float) (audioProcessor.getAnalyzer().getSampleRate() / AnalyzerData::fftSize);
+    const auto width = spectrumArea.getWidth();
+    juce::Path path;
+
+    for (int x = 0; x < width; ++x)
+    {
+        const auto lowFrequency = minFrequency * std::pow (maxFrequency / minFrequency, (float) x / (float) width);
+        const auto highFrequency = minFrequency * std::pow (maxFrequency / minFrequency, (float) (x + 1) / (float) width);
+        const auto lowBin = juce::jlimit (1, AnalyzerData::numBins - 1, juce::roundToInt (lowFrequency / binWidth));
+        const auto highBin = juce::jlimit (lowBin, AnalyzerData::numBins - 1, juce::roundToInt (highFrequency / binWidth));
+
+        auto level = AnalyzerData::minDecibels;
+
+        for (int bin = lowBin; bin <= highBin; ++bin)
+            level = juce::jmax (level, spectrum[(size_t) bin]);
+
+        const auto y = juce::jmap (level, AnalyzerData::minDecibels, 0.0f, area.getBottom(), area.getY());
+
+        if (x == 0)
+            path.startNewSubPath (area.getX(), y);
+        else
+            path.lineTo (area.getX() + (float) x, y);
+    }
+
+    g.setColour (juce::Colours::white);
+    g.strokePath (path, juce::PathStrokeType (1.5f));
+}
+
+void AnalyzerComponent::drawScope (juce::Graphics& g)
+{
+    const auto area = scopeArea.toFloat();
+
+    g.setColour (juce::Colours::white.withAlpha (0.15f));
+    g.drawHorizontalLine (juce::roundToInt (area.getCentreY()), area.getX(), area.getRight());
+
+    juce::Path path;
+
+    for (int i = 0; i < AnalyzerData::scopeSize; ++i)
+    {
+        const auto x = juce::jmap ((float) i, 0.0f, (float) (AnalyzerData::scopeSize - 1), area.getX(), area.getRight());
+        const auto y = juce::jmap (juce::jlimit (-1.0f, 1.0f, scope[(size_t) i]), -1.0f, 1.0f, area.getBottom(), area.getY());
+
+        if (i == 0)
+            path.startNewSubPath (x, y);
+        else
+            path.lineTo (x, y);
+    }
+
+    g.setColour (juce::Colour::fromRGB (247, 190, 67));
+    g.strokePath (path, juce::PathStrokeType (1.5f));
+}
+
+float AnalyzerComponent::getFrequencyX (const float frequency) const
+{
+    const auto proportion = std::log (frequency / minFrequency) / std::log (maxFrequency / minFrequency);
+    return (float) spectrumArea.getX() + proportion * (float) spectrumArea.getWidth();
+}
+
+void AnalyzerComponent::resized()
+{
+    auto bounds = getLocalBounds().reduced (20, 15).withTrimmedTop (30);
+    spectrumArea = bounds.removeFromLeft (bounds.getWidth() * 2 / 3);
+    scopeArea = bounds.withTrimmedLeft (20);
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    AnalyzerComponent.h
+    Created: 19 Oct 2026 3:12:40pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "CustomComponent.h"
+#include "../Data/HarmonicData.h"
+
+//==============================================================================
+/*
+    Log frequency spectrum with markers on the partials of the last note that
+    are switched on, next to a triggered oscilloscope. The FFT runs on the
+    high resolution timer thread; painting only reads the finished results.
+*/
+class AnalyzerComponent  : public CustomComponent
+                         , private juce::HighResolutionTimer
+{
+public:
+    AnalyzerComponent (TapSynthAudioProcessor& p);
+    ~AnalyzerComponent() override;
+
+    void paintOverChildren (juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void hiResTimerCallback() override;
+    void drawSpectrum (juce::Graphics& g);
+    void drawScope (juce::Graphics& g);
+    float getFrequencyX (const float frequency) const;
+
+    static constexpr float minFrequency { 20.0f };
+    static constexpr float maxFrequency { 20000.0f };
+    static constexpr int analyzerIntervalMs { 16 };
+
+    TapSynthAudioProcessor& audioProcessor;
+    std::array<std::atomic<float>*, HarmonicData::numPartials> partialGains {};
+    juce::Rectangle<int> spectrumArea;
+    juce::Rectangle<int> scopeArea;
+    std::array<float, AnalyzerData::numBins> spectrum;
+    std::array<float, AnalyzerData::scopeSize> scope {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyzerComponent)
+};
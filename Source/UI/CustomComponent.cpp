@@ -48,9 +48,8 @@ void SliderWithLabel::resized()
 
 CustomComponent::CustomComponent()
 {
-    // In your constructor, you should add any child components, and
-    // initialise any special settings that your component needs.
-
+    // The cached background covers every pixel, so nothing behind needs repainting
+    setOpaque (true);
 }
 
 CustomComponent::~CustomComponent()
@@ -59,6 +58,24 @@ CustomComponent::~CustomComponent()
 
 void CustomComponent::paint (juce::Graphics& g)
 {
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const auto width = juce::jmax (1, juce::roundToInt ((float) getWidth() * scale));
+    const auto height = juce::jmax (1, juce::roundToInt ((float) getHeight() * scale));
+
+    if (background.isNull() || scale != backgroundScale || background.getWidth() != width || background.getHeight() != height)
+        renderBackground (width, height, scale);
+
+    g.drawImage (background, getLocalBounds().toFloat());
+}
+
+void CustomComponent::renderBackground (const int width, const int height, const float scale)
+{
+    backgroundScale = scale;
+    background = juce::Image (juce::Image::RGB, width, height, false);
+
+    juce::Graphics g (background);
+    g.addTransform (juce::AffineTransform::scale (scale));
+
     g.fillAll (juce::Colours::black);
     auto bounds = getLocalBounds();
     g.setColour (boundsColour);
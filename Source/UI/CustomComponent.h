@@ -47,12 +47,18 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
     
-    void setName (juce::String n) { name = n; }
-    void setBoundsColour (juce::Colour c) { boundsColour = c; }
+    void setName (juce::String n) { name = n; background = {}; repaint(); }
+    void setBoundsColour (juce::Colour c) { boundsColour = c; background = {}; repaint(); }
 
 private:
+    void renderBackground (const int width, const int height, const float scale);
+
     juce::String name { "" };
     juce::Colour boundsColour { juce::Colours::white };
+
+    // Background, border and name only change with size, name or colour
+    juce::Image background;
+    float backgroundScale { 0.0f };
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CustomComponent)
 };
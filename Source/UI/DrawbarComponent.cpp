@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    DrawbarComponent.cpp
+    Created: 19 Oct 2026 4:05:18pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DrawbarComponent.h"
+
+//==============================================================================
+DrawbarComponent::DrawbarComponent (juce::AudioProcessorValueTreeState& apvts, juce::String morphOnId, juce::String morphId)
+{
+    const auto& partials = HarmonicData::getPartials();
+
+    // The fundamental stays on the oscillator panel
+    for (int i = 0; i < HarmonicData::numPartials; ++i)
+    {
+        if (HarmonicData::isFundamental (i))
+            continue;
+
+        auto* parameter = apvts.getParameter (partials[(size_t) i].paramId);
+        jassert (parameter != nullptr);
+
+        parameter->addListener (this);
+        parameters.push_back (parameter);
+        partialIndex.push_back (i);
+    }
+
+    inGesture.resize (parameters.size(), false);
+
+    for (int slot = 0; slot < (int) storeButtons.size(); ++slot)
+    {
+        auto& button = storeButtons[(size_t) slot];
+        button.setButtonText ("Store " + juce::String::charToString ((juce::juce_wchar) ('A' + slot)));
+        button.onClick = [this, slot]
+        {
+            if (onStoreSnapshot != nullptr)
+                onStoreSnapshot (slot);
+        };
+        addAndMakeVisible (button);
+    }
+
+    addAndMakeVisible (morphButton);
+    morphButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, morphOnId, morphButton);
+
+    morphSlider.setSliderStyle (juce::Slider::SliderStyle::LinearHorizontal);
+    morphSlider.setTextBoxStyle (juce::Slider::NoTextBox, true, 0, 0);
+    addAndMakeVisible (morphSlider);
+    morphSliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, morphId, morphSlider);
+}
+
+DrawbarComponent::~DrawbarComponent()
+{
+    for (auto* parameter : parameters)
+        parameter->removeListener (this);
+
+    cancelPendingUpdate();
+}
+
+void DrawbarComponent::paintOverChildren (juce::Graphics& g)
+{
+    const auto numBars = (int) parameters.size();
+
+    if (numBars == 0 || barArea.isEmpty())
+        return;
+
+    const auto barWidth = (float) barArea.getWidth() / (float) numBars;
+    const auto area = barArea.toFloat();
+    const auto& partials = HarmonicData::getPartials();
+
+    // Label 1 and every labelStep-th partial when the bars are too narrow to label them all
+    const auto labelStep = juce::jmax (1, (int) std::ceil (minLabelSpacing / barWidth));
+
+    for (int i = 0; i < numBars; ++i)
+    {
+        const auto x = area.getX() + barWidth * (float) i;
+        const auto height = area.getHeight() * parameters[(size_t) i]->getValue();
+
+        // Subharmonics in the filter colour, overtones in the oscillator colour
+        const auto index = partialIndex[(size_t) i];
+        const auto gap = juce::jmin (3.0f, barWidth * 0.2f);
+
+        g.setColour (HarmonicData::isSubharmonic (index) ? juce::Colour::fromRGB (246, 87, 64) : juce::Colour::fromRGB (247, 190, 67));
+        g.fillRoundedRectangle (x + gap, area.getBottom() - height, barWidth - 2.0f * gap, height, juce::jmin (3.0f, barWidth * 0.25f));
+
+        const auto number = HarmonicData::getPartialNumber (index);
+
+        if (number == 1 || number % labelStep == 0)
+        {
+            g.setColour (juce::Colours::white);
+            g.drawText (partials[(size_t) index].label, juce::Rectangle<float> (x + barWidth * 0.5f - minLabelSpacing, (float) barArea.getBottom(), 2.0f * minLabelSpacing, (float) labelHeight), juce::Justification::centred);
+        }
+    }
+
+    g.setColour (juce::Colours::white.withAlpha (0.3f));
+    g.drawRect (barArea);
+}
+
+void DrawbarComponent::resized()
+{
+    barArea = getLocalBounds().reduced (20, 15).withTrimmedTop (30).withTrimmedBottom (labelHeight);
+
+    // Snapshot and morph controls in the header, right aligned
+    auto header = getLocalBounds().reduced (20, 15).removeFromTop (25);
+    morphSlider.setBounds (header.removeFromRight (200));
+    morphButton.setBounds (header.removeFromRight (70));
+
+    for (auto it = storeButtons.rbegin(); it != storeButtons.rend(); ++it)
+        it->setBounds (header.removeFromRight (70).reduced (2, 0));
+}
+
+void DrawbarComponent::mouseDown (const juce::MouseEvent& e)
+{
+    // Clicks in the header, labels and margins leave the bars alone
+    if (! barArea.toFloat().contains (e.position))
+        return;
+
+    lastBar = getBarAt (e.position.x);
+    lastY = e.position.y;
+
+    if (lastBar >= 0)
+        setBarFromY (lastBar, lastY);
+}
+
+void DrawbarComponent::mouseDrag (const juce::MouseEvent& e)
+{
+    // Only drags that started on a bar; once started they may leave the area and stay clamped
+    if (lastBar < 0)
+        return;
+
+    const auto bar = getBarAt (e.position.x);
+
+    if (bar < 0)
+        return;
+
+    // Fill every bar the mouse skipped over, so fast drags draw a continuous line
+    const auto step = bar > lastBar ? 1 : -1;
+
+    for (int i = lastBar; i != bar; i += step)
+    {
+        const auto proportion = (float) (i - lastBar) / (float) (bar - lastBar);
+        setBarFromY (i, lastY + (e.position.y - lastY) * proportion);
+    }
+
+    setBarFromY (bar, e.position.y);
+
+    lastBar = bar;
+    lastY = e.position.y;
+}
+
+void DrawbarComponent::mouseUp (const juce::MouseEvent& e)
+{
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (inGesture[i])
+        {
+            parameters[i]->endChangeGesture();
+            inGesture[i] = false;
+        }
+    }
+
+    lastBar = -1;
+}
+
+void DrawbarComponent::parameterValueChanged (int parameterIndex, float newValue)
+{
+    // May arrive on the audio thread when the host automates
+    triggerAsyncUpdate();
+}
+
+void DrawbarComponent::handleAsyncUpdate()
+{
+    repaint (barArea);
+}
+
+int DrawbarComponent::getBarAt (const float x) const
+{
+    if (barArea.isEmpty() || parameters.empty())
+        return -1;
+
+    const auto proportion = (x - (float) barArea.getX()) / (float) barArea.getWidth();
+    return juce::jlimit (0, (int) parameters.size() - 1, (int) std::floor (proportion * (float) parameters.size()));
+}
+
+void DrawbarComponent::setBarFromY (const int bar, const float y)
+{
+    auto* parameter = parameters[(size_t) bar];
+
+    if (! inGesture[(size_t) bar])
+    {
+        parameter->beginChangeGesture();
+        inGesture[(size_t) bar] = true;
+    }
+
+    const auto value = juce::jlimit (0.0f, 1.0f, ((float) barArea.getBottom() - y) / (float) barArea.getHeight());
+    parameter->setValueNotifyingHost (value);
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    DrawbarComponent.h
+    Created: 19 Oct 2026 4:05:18pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CustomComponent.h"
+#include "../Data/HarmonicData.h"
+#include "../Data/SpectralMorphData.h"
+
+//==============================================================================
+/*
+    Every subharmonic and overtone gain in the HarmonicData table as one row
+    of bars, lowest subharmonic first. Clicking sets a bar, dragging across
+    the row draws a spectrum. One listener is registered on every parameter
+    and repaints asynchronously, so host automation shows up without a timer.
+
+    Above the bars, the current spectrum can be stored as a morph snapshot
+    and the morph switched on and moved.
+*/
+class DrawbarComponent  : public CustomComponent
+                        , private juce::AudioProcessorParameter::Listener
+                        , private juce::AsyncUpdater
+{
+public:
+    DrawbarComponent (juce::AudioProcessorValueTreeState& apvts, juce::String morphOnId, juce::String morphId);
+    ~DrawbarComponent() override;
+
+    void paintOverChildren (juce::Graphics& g) override;
+    void resized() override;
+
+    void mouseDown (const juce::MouseEvent& e) override;
+    void mouseDrag (const juce::MouseEvent& e) override;
+    void mouseUp (const juce::MouseEvent& e) override;
+
+    // Called with the slot of the snapshot button that was clicked
+    std::function<void (int)> onStoreSnapshot;
+
+private:
+    void parameterValueChanged (int parameterIndex, float newValue) override;
+    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override {}
+    void handleAsyncUpdate() override;
+
+    int getBarAt (const float x) const;
+    void setBarFromY (const int bar, const float y);
+
+    std::vector<juce::RangedAudioParameter*> parameters;
+    std::vector<bool> inGesture;
+    std::vector<int> partialIndex;
+
+    std::array<juce::TextButton, SpectralMorphData::numSnapshots> storeButtons;
+    juce::ToggleButton morphButton { "Morph" };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> morphButtonAttachment;
+    juce::Slider morphSlider;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> morphSliderAttachment;
+
+    juce::Rectangle<int> barArea;
+    int lastBar { -1 };
+    float lastY { 0.0f };
+
+    static constexpr int labelHeight { 20 };
+    static constexpr float minLabelSpacing { 24.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DrawbarComponent)
+};
@@ -29,23 +29,41 @@ void MeterComponent::paintOverChildren (juce::Graphics& g)
     auto leftMeter = bounds.removeFromTop (bounds.getHeight() / 2).reduced (0, 5);
     auto rightMeter = bounds.reduced (0, 5);
     
-    g.setColour (juce::Colour::fromRGB (247, 190, 67));
-    const std::atomic<float>& rms = audioProcessor.getRMS();
-    auto rmsLevel = juce::jmap<float> (rms.load(), 0.0f, 1.0f, 0.1f, leftMeter.getWidth());
-    
-    g.fillRoundedRectangle (leftMeter.getX(), leftMeter.getY(), rmsLevel, leftMeter.getHeight(), 5);
-    g.fillRoundedRectangle (rightMeter.getX(), rightMeter.getY(), rmsLevel, rightMeter.getHeight(), 5);
-    
-    g.setColour (juce::Colour::fromRGB (246, 87, 64).withAlpha (0.5f));
-    const std::atomic<float>& peak = audioProcessor.getPeak();
-    auto peakLevel = juce::jmap<float> (peak.load(), 0.0f, 1.0f, 0.1f, leftMeter.getWidth());
-    
-    g.fillRoundedRectangle (leftMeter.getX(), leftMeter.getY(), peakLevel, leftMeter.getHeight(), 5);
-    g.fillRoundedRectangle (rightMeter.getX(), rightMeter.getY(), peakLevel, rightMeter.getHeight(), 5);
-    
+    const auto& snapshot = audioProcessor.getMeterSnapshot();
+    const std::array<juce::Rectangle<int>, 2> meters { leftMeter, rightMeter };
+
+    for (size_t ch = 0; ch < meters.size(); ++ch)
+    {
+        const auto& m = meters[ch];
+
+        g.setColour (juce::Colour::fromRGB (247, 190, 67));
+        auto rmsLevel = juce::jmap<float> (juce::jmin (snapshot.rms[ch], 1.0f), 0.0f, 1.0f, 0.1f, m.getWidth());
+        g.fillRoundedRectangle (m.getX(), m.getY(), rmsLevel, m.getHeight(), 5);
+
+        g.setColour (juce::Colour::fromRGB (246, 87, 64).withAlpha (0.5f));
+        auto peakLevel = juce::jmap<float> (juce::jmin (snapshot.truePeak[ch], 1.0f), 0.0f, 1.0f, 0.1f, m.getWidth());
+        g.fillRoundedRectangle (m.getX(), m.getY(), peakLevel, m.getHeight(), 5);
+    }
+
     g.setColour (juce::Colours::white);
     g.drawRoundedRectangle (leftMeter.toFloat(), 5, 2.0f);
     g.drawRoundedRectangle (rightMeter.toFloat(), 5, 2.0f);
+
+    const auto maxTruePeak = juce::jmax (snapshot.maxTruePeak[0], snapshot.maxTruePeak[1]);
+    const auto loudness = juce::String::formatted ("M %.1f  S %.1f LUFS  TP %.1f dBTP",
+                                                   snapshot.momentaryLoudness,
+                                                   snapshot.shortTermLoudness,
+                                                   juce::Decibels::gainToDecibels (maxTruePeak));
+
+    g.setFont (fontHeight - 3.0f);
+    g.drawText (loudness, 90, 15, getWidth() - 110, 25, juce::Justification::right);
+
+    // Stands out while the governor is holding quality back
+    const auto quality = audioProcessor.getQuality();
+    const auto load = juce::String::formatted ("CPU %d%%  ", juce::roundToInt (100.0f * audioProcessor.getLoad())) + GovernorData::getQualityNames()[quality];
+
+    g.setColour (quality == GovernorData::full ? juce::Colours::white : juce::Colour::fromRGB (246, 87, 64));
+    g.drawText (load, 20, getHeight() - 27, getWidth() - 40, 20, juce::Justification::right);
 }
 
 void MeterComponent::resized()
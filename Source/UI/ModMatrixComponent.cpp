@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ModMatrixComponent.cpp
+    Created: 19 Oct 2026 10:58:32pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ModMatrixComponent.h"
+
+//==============================================================================
+ModMatrixComponent::ModMatrixComponent (juce::AudioProcessorValueTreeState& apvts)
+{
+    for (int r = 0; r < (int) rows.size(); ++r)
+    {
+        auto& row = rows[(size_t) r];
+        const auto route = "MOD" + juce::String (r + 1);
+
+        row.source.addItemList (ModMatrixData::getSourceNames(), 1);
+        row.source.setSelectedItemIndex (0);
+        addAndMakeVisible (row.source);
+        row.sourceAttachment = std::make_unique<ComboBoxAttachment>(apvts, route + "SOURCE", row.source);
+
+        row.destination.addItemList (ModMatrixData::getDestinationNames(), 1);
+        row.destination.setSelectedItemIndex (0);
+        addAndMakeVisible (row.destination);
+        row.destinationAttachment = std::make_unique<ComboBoxAttachment>(apvts, route + "DEST", row.destination);
+
+        row.depth.setSliderStyle (juce::Slider::SliderStyle::LinearHorizontal);
+        row.depth.setTextBoxStyle (juce::Slider::TextBoxRight, true, 40, 20);
+        addAndMakeVisible (row.depth);
+        row.depthAttachment = std::make_unique<SliderAttachment>(apvts, route + "DEPTH", row.depth);
+    }
+
+    setName ("Modulation");
+}
+
+ModMatrixComponent::~ModMatrixComponent()
+{
+}
+
+void ModMatrixComponent::resized()
+{
+    auto area = getLocalBounds().reduced (20, 15).withTrimmedTop (30);
+    const auto rowsPerColumn = ((int) rows.size() + numRowColumns - 1) / numRowColumns;
+    const auto columnWidth = area.getWidth() / numRowColumns;
+    const auto rowHeight = area.getHeight() / rowsPerColumn;
+
+    for (int r = 0; r < (int) rows.size(); ++r)
+    {
+        auto& row = rows[(size_t) r];
+        auto bounds = juce::Rectangle<int> (area.getX() + (r / rowsPerColumn) * columnWidth, area.getY() + (r % rowsPerColumn) * rowHeight, columnWidth, rowHeight).reduced (4, 3);
+
+        row.source.setBounds (bounds.removeFromLeft (bounds.getWidth() * 3 / 10));
+        row.destination.setBounds (bounds.removeFromLeft (bounds.getWidth() / 2).withTrimmedLeft (4));
+        row.depth.setBounds (bounds.withTrimmedLeft (4));
+    }
+}
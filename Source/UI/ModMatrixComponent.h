@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    ModMatrixComponent.h
+    Created: 19 Oct 2026 10:58:32pm
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CustomComponent.h"
+#include "../Data/ModMatrixData.h"
+
+//==============================================================================
+/*
+    One row per modulation route: source, destination and depth, laid out
+    in two columns of rows.
+*/
+class ModMatrixComponent  : public CustomComponent
+{
+public:
+    ModMatrixComponent (juce::AudioProcessorValueTreeState& apvts);
+    ~ModMatrixComponent() override;
+
+    void resized() override;
+
+private:
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+
+    struct Row
+    {
+        juce::ComboBox source;
+        juce::ComboBox destination;
+        juce::Slider depth;
+        std::unique_ptr<ComboBoxAttachment> sourceAttachment;
+        std::unique_ptr<ComboBoxAttachment> destinationAttachment;
+        std::unique_ptr<SliderAttachment> depthAttachment;
+    };
+
+    std::array<Row, ModMatrixData::maxRoutes> rows;
+
+    static constexpr int numRowColumns { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModMatrixComponent)
+};
@@ -12,10 +12,14 @@
 #include "OscComponent.h"
 
 //==============================================================================
-OscComponent::OscComponent (juce::AudioProcessorValueTreeState& apvts, juce::String oscId, juce::String gainId, juce::String pitchId, juce::String fmFreqId, juce::String fmDepthId)
+OscComponent::OscComponent (juce::AudioProcessorValueTreeState& apvts, juce::String oscId, juce::String modeId, juce::String seriesId, juce::String stretchId, juce::String gainId, juce::String pitchId, juce::String unisonId, juce::String detuneId, juce::String spreadId, juce::String fmRatioId, juce::String fmDepthId)
 : gain ("Gain", gainId, apvts, dialWidth, dialHeight)
+, stretch ("Stretch", stretchId, apvts, dialWidth, dialHeight)
 , pitch ("Pitch", pitchId, apvts, dialWidth, dialHeight)
-, fmFreq ("FM Freq", fmFreqId, apvts, dialWidth, dialHeight)
+, unison ("Unison", unisonId, apvts, dialWidth, dialHeight)
+, detune ("Detune", detuneId, apvts, dialWidth, dialHeight)
+, spread ("Spread", spreadId, apvts, dialWidth, dialHeight)
+, fmRatio ("FM Ratio", fmRatioId, apvts, dialWidth, dialHeight)
 , fmDepth ("FM Depth", fmDepthId, apvts, dialWidth, dialHeight)
 {
     juce::StringArray oscChoices { "Sine", "Saw", "Square" };
@@ -24,11 +28,57 @@ OscComponent::OscComponent (juce::AudioProcessorValueTreeState& apvts, juce::Str
     addAndMakeVisible (oscSelector);
     
     oscSelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, oscId, oscSelector);
+
+    juce::StringArray modeChoices { "Oscillators", "IFFT" };
+    modeSelector.addItemList (modeChoices, 1);
+    modeSelector.setSelectedItemIndex (0);
+    addAndMakeVisible (modeSelector);
+
+    modeSelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, modeId, modeSelector);
+
+    juce::StringArray seriesChoices { "Harmonic", "Stretched", "Bell", "Bar", "User" };
+    seriesSelector.addItemList (seriesChoices, 1);
+    seriesSelector.setSelectedItemIndex (0);
+    addAndMakeVisible (seriesSelector);
+
+    seriesSelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, seriesId, seriesSelector);
+
+    loadRatiosButton.onClick = [this]
+    {
+        ratiosChooser = std::make_unique<juce::FileChooser> ("Load Partial Ratios", juce::File(), "*.txt");
+
+        ratiosChooser->launchAsync (juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles, [this] (const juce::FileChooser& chooser)
+        {
+            auto file = chooser.getResult();
+
+            if (file.existsAsFile() && onPartialRatiosChosen != nullptr)
+                onPartialRatiosChosen (file);
+        });
+    };
+    addAndMakeVisible (loadRatiosButton);
+
+    loadTuningButton.onClick = [this]
+    {
+        tuningChooser = std::make_unique<juce::FileChooser> ("Load Scala Scale or Keyboard Mapping", juce::File(), "*.scl;*.kbm");
+
+        tuningChooser->launchAsync (juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles, [this] (const juce::FileChooser& chooser)
+        {
+            auto file = chooser.getResult();
+
+            if (file.existsAsFile() && onTuningChosen != nullptr)
+                onTuningChosen (file);
+        });
+    };
+    addAndMakeVisible (loadTuningButton);
     
     addAndMakeVisible (gain);
-    //addAndMakeVisible (pitch);
-    //addAndMakeVisible (fmFreq);
-    //addAndMakeVisible (fmDepth);
+    addAndMakeVisible (stretch);
+    addAndMakeVisible (pitch);
+    addAndMakeVisible (unison);
+    addAndMakeVisible (detune);
+    addAndMakeVisible (spread);
+    addAndMakeVisible (fmRatio);
+    addAndMakeVisible (fmDepth);
 }
 
 OscComponent::~OscComponent()
@@ -43,8 +93,16 @@ void OscComponent::resized()
     const auto height = 88;
     
     oscSelector.setBounds (18, 40, 100, 25);
+    modeSelector.setBounds (18, 70, 100, 25);
+    seriesSelector.setBounds (18, 100, 100, 25);
     gain.setBounds (120, yStart, width, height);
-    //pitch.setBounds (190, yStart, width, height);
-    //fmFreq.setBounds (260, yStart, width, height);
-    //fmDepth.setBounds (330, yStart, width, height);
+    stretch.setBounds (gain.getRight(), yStart, width, height);
+    loadRatiosButton.setBounds (gain.getX(), gain.getBottom() + 5, width, 25);
+    loadTuningButton.setBounds (stretch.getX(), gain.getBottom() + 5, width, 25);
+    pitch.setBounds (stretch.getRight(), yStart, width, height);
+    unison.setBounds (pitch.getRight(), yStart, width, height);
+    detune.setBounds (unison.getRight(), yStart, width, height);
+    spread.setBounds (detune.getRight(), yStart, width, height);
+    fmRatio.setBounds (spread.getRight(), yStart, width, height);
+    fmDepth.setBounds (fmRatio.getRight(), yStart, width, height);
 }
@@ -19,18 +19,37 @@
 class OscComponent : public CustomComponent
 {
 public:
-    OscComponent (juce::AudioProcessorValueTreeState& apvts, juce::String oscId, juce::String gainId, juce::String pitchId, juce::String fmPitchId, juce::String fmFreqId);
+    OscComponent (juce::AudioProcessorValueTreeState& apvts, juce::String oscId, juce::String modeId, juce::String seriesId, juce::String stretchId, juce::String gainId, juce::String pitchId, juce::String unisonId, juce::String detuneId, juce::String spreadId, juce::String fmRatioId, juce::String fmDepthId);
     ~OscComponent() override;
 
     void resized() override;
 
+    std::function<void (const juce::File&)> onPartialRatiosChosen;
+    std::function<void (const juce::File&)> onTuningChosen;
+
 private:
     juce::ComboBox oscSelector;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oscSelAttachment;
+
+    juce::ComboBox modeSelector;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modeSelAttachment;
+
+    juce::ComboBox seriesSelector;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> seriesSelAttachment;
+
+    juce::TextButton loadRatiosButton { "Ratios" };
+    std::unique_ptr<juce::FileChooser> ratiosChooser;
+
+    juce::TextButton loadTuningButton { "Tuning" };
+    std::unique_ptr<juce::FileChooser> tuningChooser;
     
     SliderWithLabel gain;
+    SliderWithLabel stretch;
     SliderWithLabel pitch;
-    SliderWithLabel fmFreq;
+    SliderWithLabel unison;
+    SliderWithLabel detune;
+    SliderWithLabel spread;
+    SliderWithLabel fmRatio;
     SliderWithLabel fmDepth;
     
     static constexpr int dialWidth = 70;
@@ -12,7 +12,7 @@
 #include "ReverbComponent.h"
 
 //==============================================================================
-ReverbComponent::ReverbComponent (juce::AudioProcessorValueTreeState& apvts, juce::String sizeId, juce::String dampingId, juce::String widthId, juce::String dryId, juce::String wetId, juce::String freezeId)
+ReverbComponent::ReverbComponent (juce::AudioProcessorValueTreeState& apvts, juce::String sizeId, juce::String dampingId, juce::String widthId, juce::String dryId, juce::String wetId, juce::String freezeId, juce::String engineId, juce::String qualityId)
 : size ("Size", sizeId, apvts, dialWidth, dialHeight)
 , damping ("Damping", dampingId, apvts, dialWidth, dialHeight)
 , stereoWidth ("Width", widthId, apvts, dialWidth, dialHeight)
@@ -20,6 +20,32 @@ ReverbComponent::ReverbComponent (juce::AudioProcessorValueTreeState& apvts, juc
 , wet ("Wet", wetId, apvts, dialWidth, dialHeight)
 , freeze ("Freeze", freezeId, apvts, dialWidth, dialHeight)
 {
+    juce::StringArray engineChoices { "Freeverb", "FDN", "Convolution" };
+    engineSelector.addItemList (engineChoices, 1);
+    engineSelector.setSelectedItemIndex (0);
+    addAndMakeVisible (engineSelector);
+    engineAttachment = std::make_unique<ComboBoxAttachment>(apvts, engineId, engineSelector);
+
+    juce::StringArray qualityChoices { "Eco", "Standard", "High", "Ultra" };
+    qualitySelector.addItemList (qualityChoices, 1);
+    qualitySelector.setSelectedItemIndex (1);
+    addAndMakeVisible (qualitySelector);
+    qualityAttachment = std::make_unique<ComboBoxAttachment>(apvts, qualityId, qualitySelector);
+
+    loadImpulseButton.onClick = [this]
+    {
+        impulseChooser = std::make_unique<juce::FileChooser> ("Load Impulse Response", juce::File(), "*.wav;*.aif;*.aiff;*.flac");
+
+        impulseChooser->launchAsync (juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles, [this] (const juce::FileChooser& chooser)
+        {
+            auto file = chooser.getResult();
+
+            if (file.existsAsFile() && onImpulseResponseChosen != nullptr)
+                onImpulseResponseChosen (file);
+        });
+    };
+    addAndMakeVisible (loadImpulseButton);
+
     addAndMakeVisible (size);
     addAndMakeVisible (damping);
     addAndMakeVisible (stereoWidth);
@@ -46,5 +72,9 @@ void ReverbComponent::resized()
     dry.setBounds (stereoWidth.getRight(), yStart, width, height);
     wet.setBounds (dry.getRight(), yStart, width, height);
     freeze.setBounds (wet.getRight(), yStart, width, height);
+
+    engineSelector.setBounds (freeze.getRight() + 5, yStart, 80, 25);
+    qualitySelector.setBounds (freeze.getRight() + 5, engineSelector.getBottom() + 5, 80, 25);
+    loadImpulseButton.setBounds (freeze.getRight() + 5, qualitySelector.getBottom() + 5, 80, 25);
 }
 
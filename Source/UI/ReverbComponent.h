@@ -19,12 +19,24 @@
 class ReverbComponent  : public CustomComponent
 {
 public:
-    ReverbComponent (juce::AudioProcessorValueTreeState& apvts, juce::String sizeId, juce::String dampingId, juce::String widthId, juce::String dryId, juce::String wetId, juce::String freezeId);
+    ReverbComponent (juce::AudioProcessorValueTreeState& apvts, juce::String sizeId, juce::String dampingId, juce::String widthId, juce::String dryId, juce::String wetId, juce::String freezeId, juce::String engineId, juce::String qualityId);
     ~ReverbComponent() override;
 
     void resized() override;
+
+    std::function<void (const juce::File&)> onImpulseResponseChosen;
 
 private:
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+
+    juce::ComboBox engineSelector;
+    juce::ComboBox qualitySelector;
+    std::unique_ptr<ComboBoxAttachment> engineAttachment;
+    std::unique_ptr<ComboBoxAttachment> qualityAttachment;
+
+    juce::TextButton loadImpulseButton { "Load IR" };
+    std::unique_ptr<juce::FileChooser> impulseChooser;
+
     SliderWithLabel size;
     SliderWithLabel damping;
     SliderWithLabel stereoWidth;
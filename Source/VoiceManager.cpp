@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    VoiceManager.cpp
+    Created: 20 Oct 2026 12:31:44am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#include "VoiceManager.h"
+
+void VoiceManager::addSynthVoice (SynthVoice* newVoice)
+{
+    jassert (numSynthVoices < maxVoices);
+    jassert (newVoice->getVoiceIndex() == numSynthVoices);
+
+    newVoice->setActiveVoices (activeVoices);
+    synthVoices[(size_t) numSynthVoices++] = newVoice;
+    addVoice (newVoice);
+}
+
+juce::uint32 VoiceManager::getVoicesToUpdate (const int numNoteOns) const noexcept
+{
+    auto mask = activeVoices;
+    auto remaining = numNoteOns;
+
+    for (int i = 0; i < numSynthVoices && remaining > 0; ++i)
+    {
+        if ((activeVoices & (1u << i)) == 0)
+        {
+            mask |= 1u << i;
+            --remaining;
+        }
+    }
+
+    return mask;
+}
+
+juce::SynthesiserVoice* VoiceManager::findFreeVoice (juce::SynthesiserSound* soundToPlay, int midiChannel, int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+    for (int i = 0; i < numSynthVoices; ++i)
+        if ((activeVoices & (1u << i)) == 0 && synthVoices[(size_t) i]->canPlaySound (soundToPlay))
+            return synthVoices[(size_t) i];
+
+    if (stealIfNoneAvailable)
+        return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
+
+    return nullptr;
+}
+
+void VoiceManager::renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    // A copy, as voices clear their bits as they end
+    forEachVoice (activeVoices, [&] (int, SynthVoice& voice) { voice.renderNextBlock (outputAudio, startSample, numSamples); });
+}
+
+void VoiceManager::renderVoices (juce::AudioBuffer<double>& outputAudio, int startSample, int numSamples)
+{
+    forEachVoice (activeVoices, [&] (int, SynthVoice& voice) { voice.renderNextBlock (outputAudio, startSample, numSamples); });
+}
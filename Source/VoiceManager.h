@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    VoiceManager.h
+    Created: 20 Oct 2026 12:31:44am
+    Author:  morchella
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SynthVoice.h"
+
+// A juce::Synthesiser that keeps its voices as SynthVoice pointers, and a
+// bitmask with a bit per voice that is set while the voice plays. The voices
+// set and clear their own bits as notes start and end. Rendering and the
+// per-block parameter pushes walk the mask, so their cost follows the voices
+// playing rather than the voices allocated, and nothing needs a
+// dynamic_cast on the audio thread.
+//
+// Note on and off matching stays in juce::Synthesiser, which keeps the key
+// and pedal state of its voices to itself.
+class VoiceManager : public juce::Synthesiser
+{
+public:
+    static constexpr int maxVoices { ExpressionData::maxVoices };
+    static_assert (maxVoices <= 32, "One bit per voice");
+
+    // Takes ownership, like addVoice()
+    void addSynthVoice (SynthVoice* newVoice);
+
+    int getNumSynthVoices() const noexcept { return numSynthVoices; }
+    SynthVoice& getSynthVoice (const int index) noexcept { return *synthVoices[(size_t) index]; }
+
+    // The voices playing, plus the idle ones the next numNoteOns notes will
+    // start on, so they can be set up before they play
+    juce::uint32 getVoicesToUpdate (const int numNoteOns) const noexcept;
+
+    // Calls function (index, voice) for every voice in mask
+    template <typename Function>
+    void forEachVoice (juce::uint32 mask, Function&& function)
+    {
+        for (int i = 0; mask != 0; ++i, mask >>= 1)
+            if ((mask & 1) != 0)
+                function (i, *synthVoices[(size_t) i]);
+    }
+
+    template <typename Function>
+    void forEachVoice (Function&& function) { forEachVoice (getAllVoices(), function); }
+
+protected:
+    // The lowest idle voice, so getVoicesToUpdate() knows which will start
+    juce::SynthesiserVoice* findFreeVoice (juce::SynthesiserSound* soundToPlay, int midiChannel, int midiNoteNumber, bool stealIfNoneAvailable) const override;
+
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    void renderVoices (juce::AudioBuffer<double>& outputAudio, int startSample, int numSamples) override;
+
+private:
+    juce::uint32 getAllVoices() const noexcept { return numSynthVoices == 32 ? ~0u : (1u << numSynthVoices) - 1; }
+
+    std::array<SynthVoice*, maxVoices> synthVoices {};
+    int numSynthVoices { 0 };
+
+    // Bit i is voice i; written by the voices
+    juce::uint32 activeVoices { 0 };
+};